@@ -0,0 +1,406 @@
+#include "query_server.h"
+#include <warthog/constants.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/search_parameters.h>
+#include <warthog/search/solution.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/locality_order.h>
+#include <warthog/util/pqueue.h>
+
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace warthog::util
+{
+
+namespace
+{
+
+// queries waiting for a worker, per worker, before readers block
+constexpr size_t QUEUED_PER_WORKER = 1024;
+
+bool
+write_all(int fd, const char* data, size_t size)
+{
+	while(size)
+	{
+		ssize_t n = ::write(fd, data, size);
+		if(n < 0 && errno == EINTR) { continue; }
+		if(n <= 0) { return false; }
+		data += n;
+		size -= n;
+	}
+	return true;
+}
+
+// parse the next unsigned number of @param line from @param pos
+bool
+next_number(const std::string& line, size_t& pos, uint32_t& value)
+{
+	pos = line.find_first_not_of(" \t\r", pos);
+	if(pos == std::string::npos) { return false; }
+	const char* end = line.data() + line.size();
+	auto [ptr, ec]  = std::from_chars(line.data() + pos, end, value);
+	if(ec != std::errc() || (ptr != end && !std::isspace(*ptr)))
+	{
+		return false;
+	}
+	pos = ptr - line.data();
+	return true;
+}
+
+} // namespace
+
+struct query_server::worker
+{
+	worker(domain::gridmap* map, const domain::move_table* moves)
+	    : expander_(map, false, moves),
+	      heuristic_(map->width(), map->height()),
+	      astar_(&heuristic_, &expander_, &open_)
+	{ }
+
+	search::gridmap_expansion_policy expander_;
+	heuristic::octile_heuristic heuristic_;
+	pqueue_min open_;
+	search::unidirectional_search<
+	    heuristic::octile_heuristic, search::gridmap_expansion_policy,
+	    pqueue_min>
+	    astar_;
+	search::search_parameters par_;
+};
+
+// one client: where its queries come from and its results go to, and
+// how many of its queries are still being solved
+struct query_server::connection
+{
+	int in_fd_;
+	int out_fd_;
+	std::mutex mutex_;
+	std::condition_variable drained_;
+	uint32_t pending_ = 0;
+};
+
+query_server::query_server(
+    domain::gridmap& map, const domain::move_table* moves, uint32_t workers,
+    bool binary, uint32_t window)
+    : map_(map), moves_(moves), binary_(binary), window_(window),
+      stop_(false)
+{
+	// expanders are given the current snapshot for each query
+	auto snap = map_.acquire();
+	for(uint32_t i = 0; i < workers; i++)
+	{
+		workers_.push_back(std::make_unique<worker>(snap.get(), moves));
+	}
+	for(auto& w : workers_)
+	{
+		threads_.emplace_back([this, &w] { work_(*w); });
+	}
+}
+
+query_server::~query_server()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	ready_.notify_all();
+	for(auto& t : threads_)
+	{
+		t.join();
+	}
+}
+
+void
+query_server::serve(int in_fd, int out_fd)
+{
+	connection conn;
+	conn.in_fd_  = in_fd;
+	conn.out_fd_ = out_fd;
+	if(binary_) { read_binary_(conn); }
+	else { read_text_(conn); }
+
+	std::unique_lock<std::mutex> lock(conn.mutex_);
+	conn.drained_.wait(lock, [&conn] { return conn.pending_ == 0; });
+}
+
+bool
+query_server::listen(const std::string& path)
+{
+	sockaddr_un addr{};
+	if(path.size() >= sizeof(addr.sun_path))
+	{
+		std::cerr << "err; socket path too long: " << path << "\n";
+		return false;
+	}
+	addr.sun_family = AF_UNIX;
+	std::strcpy(addr.sun_path, path.c_str());
+
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	::unlink(path.c_str());
+	if(fd < 0 || ::bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0
+	   || ::listen(fd, 64) != 0)
+	{
+		std::cerr << "err; cannot listen on " << path << ": "
+		          << std::strerror(errno) << "\n";
+		if(fd >= 0) { ::close(fd); }
+		return false;
+	}
+
+	// a client that goes away must not take the server with it
+	std::signal(SIGPIPE, SIG_IGN);
+	while(true)
+	{
+		int client = ::accept(fd, nullptr, nullptr);
+		if(client < 0)
+		{
+			if(errno == EINTR || errno == ECONNABORTED) { continue; }
+			std::cerr << "err; accept failed: " << std::strerror(errno)
+			          << "\n";
+			::close(fd);
+			return false;
+		}
+		std::thread([this, client] {
+			serve(client, client);
+			::close(client);
+		}).detach();
+	}
+}
+
+void
+query_server::set_recorder(query_recorder* recorder)
+{
+	for(auto& w : workers_)
+	{
+		w->par_.set_recorder(recorder);
+	}
+}
+
+void
+query_server::work_(worker& w)
+{
+	while(true)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+		if(jobs_.empty()) { return; }
+		job j = jobs_.front();
+		jobs_.pop_front();
+		lock.unlock();
+		ready_.notify_all(); // there is room for a blocked reader
+
+		reply_(*j.conn_, solve_(w, j.query_));
+		std::lock_guard<std::mutex> conn_lock(j.conn_->mutex_);
+		if(--j.conn_->pending_ == 0) { j.conn_->drained_.notify_all(); }
+	}
+}
+
+void
+query_server::submit_(const query_frame& q, connection& conn)
+{
+	{
+		std::lock_guard<std::mutex> conn_lock(conn.mutex_);
+		conn.pending_++;
+	}
+	std::unique_lock<std::mutex> lock(mutex_);
+	ready_.wait(lock, [this] {
+		return jobs_.size() < QUEUED_PER_WORKER * workers_.size();
+	});
+	jobs_.push_back({q, &conn});
+	lock.unlock();
+	ready_.notify_all();
+}
+
+void
+query_server::submit_all_(std::vector<query_frame>& batch, connection& conn)
+{
+	std::vector<uint32_t> order(batch.size());
+	std::iota(order.begin(), order.end(), 0);
+	if(window_)
+	{
+		std::vector<uint64_t> keys(batch.size());
+		for(uint32_t i = 0; i < batch.size(); i++)
+		{
+			const query_frame& q = batch[i];
+			keys[i] = locality_key(q.sx_, q.sy_, q.gx_, q.gy_);
+		}
+		locality_order(order, keys, window_);
+	}
+	for(uint32_t i : order)
+	{
+		submit_(batch[i], conn);
+	}
+	batch.clear();
+}
+
+result_frame
+query_server::solve_(worker& w, const query_frame& q)
+{
+	result_frame r{q.id_, result_frame::INVALID, 0, 0, -1, 0};
+	uint32_t width = map_.header_width(), height = map_.header_height();
+	if(q.sx_ >= width || q.gx_ >= width || q.sy_ >= height || q.gy_ >= height)
+	{
+		return r;
+	}
+
+	auto snap = map_.acquire();
+	w.expander_.set_map(snap.get());
+	search::problem_instance pi(
+	    w.expander_.get_pack(q.sx_, q.sy_), w.expander_.get_pack(q.gx_, q.gy_));
+	search::solution sol;
+	w.astar_.get_path(&pi, &w.par_, &sol);
+
+	r.expanded_ = sol.met_.nodes_expanded_;
+	r.nanos_    = sol.met_.time_elapsed_nano_.count();
+	if(sol.sum_of_edge_costs_ == warthog::COST_MAX)
+	{
+		r.status_ = result_frame::NO_PATH;
+		return r;
+	}
+	r.status_ = result_frame::SOLVED;
+	r.cost_   = sol.sum_of_edge_costs_;
+	r.plen_   = (uint32_t)sol.path_.size() - 1;
+	return r;
+}
+
+void
+query_server::reply_(connection& conn, const result_frame& r)
+{
+	std::lock_guard<std::mutex> lock(conn.mutex_);
+	if(binary_)
+	{
+		write_all(conn.out_fd_, (const char*)&r, sizeof(r));
+		return;
+	}
+
+	char line[128];
+	int n;
+	if(r.status_ == result_frame::INVALID)
+	{
+		n = std::snprintf(line, sizeof(line), "%u error\n", r.id_);
+	}
+	else
+	{
+		n = std::snprintf(
+		    line, sizeof(line), "%u %.*g %u %u %llu\n", r.id_,
+		    std::numeric_limits<double>::max_digits10, r.cost_, r.plen_,
+		    r.expanded_, (unsigned long long)r.nanos_);
+	}
+	write_all(conn.out_fd_, line, n);
+}
+
+void
+query_server::update_(connection& conn, const std::string& line, size_t pos)
+{
+	std::vector<domain::versioned_gridmap::edit> edits;
+	bool valid = moves_ == nullptr;
+	while(valid && line.find_first_not_of(" \t\r", pos) != std::string::npos)
+	{
+		uint32_t x = 0, y = 0, label = 0;
+		valid = next_number(line, pos, x) && next_number(line, pos, y)
+		    && next_number(line, pos, label) && x < map_.header_width()
+		    && y < map_.header_height() && label <= 1;
+		if(!valid) { break; }
+		edits.push_back({x, y, label == 1});
+	}
+
+	char reply[64];
+	int n = std::snprintf(reply, sizeof(reply), "set error\n");
+	if(valid && !edits.empty())
+	{
+		n = std::snprintf(
+		    reply, sizeof(reply), "set %llu\n",
+		    (unsigned long long)map_.commit(edits));
+	}
+	std::lock_guard<std::mutex> lock(conn.mutex_);
+	write_all(conn.out_fd_, reply, n);
+}
+
+void
+query_server::read_text_(connection& conn)
+{
+	std::string buf, line;
+	std::vector<query_frame> batch;
+	char chunk[1 << 16];
+	while(true)
+	{
+		ssize_t n = ::read(conn.in_fd_, chunk, sizeof(chunk));
+		if(n < 0 && errno == EINTR) { continue; }
+		if(n > 0) { buf.append(chunk, n); }
+
+		// at the end of the input, a last line may have no newline
+		size_t start = 0, end;
+		while((end = buf.find('\n', start)) != std::string::npos
+		      || (n <= 0 && start < buf.size()))
+		{
+			if(end == std::string::npos) { end = buf.size(); }
+			line.assign(buf, start, end - start);
+			start = end + 1;
+
+			size_t pos = line.find_first_not_of(" \t\r");
+			if(pos == std::string::npos || line[pos] == '#') { continue; }
+			if(line.compare(pos, 4, "set ") == 0)
+			{
+				submit_all_(batch, conn); // queries sent before come first
+				update_(conn, line, pos + 4);
+				continue;
+			}
+			query_frame q;
+			if(!next_number(line, pos, q.id_))
+			{
+				std::lock_guard<std::mutex> lock(conn.mutex_);
+				write_all(conn.out_fd_, "- error\n", 8);
+				continue;
+			}
+			if(!next_number(line, pos, q.sx_) || !next_number(line, pos, q.sy_)
+			   || !next_number(line, pos, q.gx_)
+			   || !next_number(line, pos, q.gy_))
+			{
+				q.sx_ = UINT32_MAX; // off the map; answered as invalid
+			}
+			batch.push_back(q);
+		}
+		submit_all_(batch, conn);
+		buf.erase(0, std::min(start, buf.size()));
+		if(n <= 0) { return; }
+	}
+}
+
+void
+query_server::read_binary_(connection& conn)
+{
+	std::vector<char> buf;
+	std::vector<query_frame> batch;
+	char chunk[sizeof(query_frame) * 4096];
+	while(true)
+	{
+		ssize_t n = ::read(conn.in_fd_, chunk, sizeof(chunk));
+		if(n < 0 && errno == EINTR) { continue; }
+		if(n <= 0) { return; } // a partial last frame is dropped
+		buf.insert(buf.end(), chunk, chunk + n);
+
+		size_t start = 0;
+		for(; start + sizeof(query_frame) <= buf.size();
+		    start += sizeof(query_frame))
+		{
+			query_frame q;
+			std::memcpy(&q, buf.data() + start, sizeof(q));
+			batch.push_back(q);
+		}
+		submit_all_(batch, conn);
+		buf.erase(buf.begin(), buf.begin() + start);
+	}
+}
+
+} // namespace warthog::util
@@ -0,0 +1,163 @@
+#ifndef WARTHOG_APP_QUERY_SERVER_H
+#define WARTHOG_APP_QUERY_SERVER_H
+
+// query_server.h
+//
+// A long-running query service for one map. The map, heuristic and any
+// precomputed move table are loaded once; queries then arrive on a
+// stream (stdin, or a connection to a Unix domain socket) and are solved
+// concurrently by a pool of workers, each with its own expansion policy,
+// node pool and open list. A result is written back as soon as its query
+// is solved, so results may come back out of order; each one carries the
+// id of its query.
+//
+// Two framings are supported:
+//  - text: one query per line, "id sx sy gx gy"; one result per line,
+//    "id cost plen expanded nanos", with cost -1 if there is no path.
+//    Queries that cannot be parsed, or are off the map, are answered
+//    with "id error" ("- error" if there is no id). Blank lines and lines
+//    starting with # are ignored.
+//  - binary: fixed-size query_frame and result_frame records, in host
+//    byte order.
+//
+// Queries that arrive together, in one read from the stream, can be
+// reordered before they are queued so that consecutive searches cover
+// nearby parts of the map (see util/locality_order.h); their results
+// still carry their ids.
+//
+// In text mode the map can also be changed while queries run. A line
+// "set x y label [x y label ...]" sets each cell (x, y) to traversable
+// (label 1) or blocked (label 0), all at once, and is answered with
+// "set version" once the change is published, or "set error". Each
+// query is solved on the version of the map that is current when a
+// worker starts it (see domain::versioned_gridmap); queries sent after
+// the reply to a "set" see its change. The map cannot be changed if the
+// server reads moves from a move table.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/domain/gridmap.h>
+#include <warthog/domain/move_table.h>
+#include <warthog/domain/versioned_gridmap.h>
+#include <warthog/util/query_log.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace warthog::util
+{
+
+struct query_frame
+{
+	uint32_t id_;
+	uint32_t sx_, sy_;
+	uint32_t gx_, gy_;
+};
+
+struct result_frame
+{
+	enum : uint32_t
+	{
+		SOLVED,
+		NO_PATH,
+		INVALID
+	};
+
+	uint32_t id_;
+	uint32_t status_;
+	uint32_t plen_; // number of moves
+	uint32_t expanded_;
+	double cost_; // -1 unless solved
+	uint64_t nanos_;
+};
+
+static_assert(sizeof(query_frame) == 20 && sizeof(result_frame) == 32);
+
+class query_server
+{
+public:
+	// the server searches a copy of @param map. @param moves may be null;
+	// it must outlive the server. queries read together are reordered
+	// for locality in windows of @param window; 0 keeps their order.
+	query_server(
+	    domain::gridmap& map, const domain::move_table* moves,
+	    uint32_t workers, bool binary, uint32_t window = 0);
+	~query_server();
+
+	// answer the queries read from @param in_fd on @param out_fd. returns
+	// at the end of the input, once every result has been written.
+	void
+	serve(int in_fd, int out_fd);
+
+	// accept connections on a Unix domain socket at @param path and serve
+	// each one, concurrently, until the process is stopped. returns
+	// false, with a message on std::cerr, if the socket cannot be opened.
+	bool
+	listen(const std::string& path);
+
+	// record the queries solved to @param recorder, which must outlive
+	// the server; null to stop recording. call before serving.
+	void
+	set_recorder(query_recorder* recorder);
+
+private:
+	struct worker;
+	struct connection;
+	struct job
+	{
+		query_frame query_;
+		connection* conn_;
+	};
+
+	domain::versioned_gridmap map_;
+	const domain::move_table* moves_;
+	bool binary_;
+	uint32_t window_;
+	std::vector<std::unique_ptr<worker>> workers_;
+	std::vector<std::thread> threads_;
+
+	std::mutex mutex_;
+	std::condition_variable ready_;
+	std::deque<job> jobs_;
+	bool stop_;
+
+	void
+	work_(worker& w);
+
+	void
+	submit_(const query_frame& q, connection& conn);
+
+	// submit the queries of @param batch, reordered by window_, and
+	// clear it
+	void
+	submit_all_(std::vector<query_frame>& batch, connection& conn);
+
+	result_frame
+	solve_(worker& w, const query_frame& q);
+
+	void
+	reply_(connection& conn, const result_frame& r);
+
+	// apply the edits of a "set" line, from @param pos of @param line
+	void
+	update_(connection& conn, const std::string& line, size_t pos);
+
+	// read queries from @param conn until the end of its input
+	void
+	read_text_(connection& conn);
+
+	void
+	read_binary_(connection& conn);
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_APP_QUERY_SERVER_H
@@ -0,0 +1,297 @@
+#include "shard_pool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <poll.h>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace warthog::util
+{
+
+namespace
+{
+
+// the reply of a worker, followed by size_ bytes of output
+struct result_header
+{
+	uint32_t task_;
+	int32_t status_;
+	uint64_t size_;
+};
+
+bool
+write_all(int fd, const void* data, size_t size)
+{
+	const char* p = (const char*)data;
+	while(size)
+	{
+		ssize_t n = ::write(fd, p, size);
+		if(n < 0 && errno == EINTR) { continue; }
+		if(n <= 0) { return false; }
+		p    += n;
+		size -= n;
+	}
+	return true;
+}
+
+// false at the end of the stream, or on an error, before @param size
+// bytes are read
+bool
+read_all(int fd, void* data, size_t size)
+{
+	char* p = (char*)data;
+	while(size)
+	{
+		ssize_t n = ::read(fd, p, size);
+		if(n < 0 && errno == EINTR) { continue; }
+		if(n <= 0) { return false; }
+		p    += n;
+		size -= n;
+	}
+	return true;
+}
+
+void
+describe_exit(std::ostream& out, int status)
+{
+	if(WIFSIGNALED(status))
+	{
+		out << "signal " << WTERMSIG(status) << " ("
+		    << strsignal(WTERMSIG(status)) << ")";
+	}
+	else if(WIFEXITED(status)) { out << "status " << WEXITSTATUS(status); }
+	else { out << "wait status " << status; }
+}
+
+} // namespace
+
+shard_pool::shard_pool(uint32_t workers, uint32_t attempts)
+    : num_workers_(std::max(1u, workers)), attempts_(std::max(1u, attempts)),
+      restarts_(0), failed_(0)
+{ }
+
+shard_pool::~shard_pool()
+{
+	for(worker& w : workers_)
+	{
+		reap_(w);
+	}
+}
+
+int
+shard_pool::run(uint32_t num_tasks, const task_fn& fn, std::ostream& out)
+{
+	// a worker may die while a task is written to it
+	std::signal(SIGPIPE, SIG_IGN);
+
+	std::deque<uint32_t> pending;
+	for(uint32_t t = 0; t < num_tasks; t++)
+	{
+		pending.push_back(t);
+	}
+	std::vector<std::string> results(num_tasks);
+	std::vector<int> status(num_tasks, 0);
+	std::vector<uint8_t> done(num_tasks, 0);
+	std::vector<uint32_t> tries(num_tasks, 0);
+	uint32_t running  = 0;
+	uint32_t next_out = 0;
+
+	while(next_out < num_tasks)
+	{
+		// keep a worker for each task left, up to the size of the pool
+		uint32_t wanted
+		    = std::min<size_t>(num_workers_, pending.size() + running);
+		while(workers_.size() < wanted && spawn_(fn)) { }
+		if(workers_.empty())
+		{
+			std::cerr << "err; cannot start workers: " << strerror(errno)
+			          << "\n";
+			return 1;
+		}
+
+		// a worker that cannot be written to has died; its result pipe
+		// reports the end of the stream below
+		for(worker& w : workers_)
+		{
+			if(w.task_ != IDLE || pending.empty()) { continue; }
+			w.task_ = pending.front();
+			pending.pop_front();
+			tries[w.task_]++;
+			running++;
+			write_all(w.task_fd_, &w.task_, sizeof(w.task_));
+		}
+
+		std::vector<pollfd> fds(workers_.size());
+		for(size_t i = 0; i < workers_.size(); i++)
+		{
+			fds[i] = {workers_[i].result_fd_, POLLIN, 0};
+		}
+		if(::poll(fds.data(), fds.size(), -1) < 0)
+		{
+			if(errno == EINTR) { continue; }
+			std::cerr << "err; poll: " << strerror(errno) << "\n";
+			return 1;
+		}
+
+		// newest first, so that removing a worker keeps the indexes of
+		// those still to be checked
+		for(size_t i = workers_.size(); i-- > 0;)
+		{
+			if(!fds[i].revents) { continue; }
+			worker& w = workers_[i];
+			result_header h;
+			std::string body;
+			bool ok = read_all(w.result_fd_, &h, sizeof(h));
+			if(ok)
+			{
+				body.resize(h.size_);
+				ok = read_all(w.result_fd_, body.data(), body.size());
+			}
+			if(ok && h.task_ == w.task_)
+			{
+				results[h.task_] = std::move(body);
+				status[h.task_]  = h.status_;
+				done[h.task_]    = 1;
+				if(h.status_ != 0) { failed_++; }
+				w.task_ = IDLE;
+				running--;
+				continue;
+			}
+
+			uint32_t task = w.task_;
+			pid_t pid     = w.pid_;
+			int wstatus   = reap_(w);
+			workers_.erase(workers_.begin() + i);
+			restarts_++;
+			std::cerr << "worker " << pid << " died with ";
+			describe_exit(std::cerr, wstatus);
+			if(task == IDLE)
+			{
+				std::cerr << "\n";
+				continue;
+			}
+			running--;
+			std::cerr << " on task " << task << ", attempt " << tries[task]
+			          << " of " << attempts_ << "\n";
+			if(tries[task] < attempts_)
+			{
+				pending.push_front(task);
+				continue;
+			}
+			status[task] = 1;
+			done[task]   = 1;
+			failed_++;
+		}
+
+		while(next_out < num_tasks && done[next_out])
+		{
+			out << results[next_out];
+			std::string().swap(results[next_out]);
+			next_out++;
+		}
+		out.flush();
+	}
+
+	for(worker& w : workers_)
+	{
+		reap_(w);
+	}
+	workers_.clear();
+	for(int s : status)
+	{
+		if(s != 0) { return s; }
+	}
+	return 0;
+}
+
+bool
+shard_pool::spawn_(const task_fn& fn)
+{
+	int task_pipe[2], result_pipe[2];
+	if(::pipe(task_pipe) != 0) { return false; }
+	if(::pipe(result_pipe) != 0)
+	{
+		::close(task_pipe[0]);
+		::close(task_pipe[1]);
+		return false;
+	}
+
+	pid_t pid = ::fork();
+	if(pid < 0)
+	{
+		for(int fd :
+		    {task_pipe[0], task_pipe[1], result_pipe[0], result_pipe[1]})
+		{
+			::close(fd);
+		}
+		return false;
+	}
+	if(pid == 0)
+	{
+		// the other workers see the end of their streams only once every
+		// copy of the coordinator's ends is closed
+		for(worker& w : workers_)
+		{
+			::close(w.task_fd_);
+			::close(w.result_fd_);
+		}
+		::close(task_pipe[1]);
+		::close(result_pipe[0]);
+		serve_(task_pipe[0], result_pipe[1], fn);
+	}
+	::close(task_pipe[0]);
+	::close(result_pipe[1]);
+	workers_.push_back({pid, task_pipe[1], result_pipe[0], IDLE});
+	return true;
+}
+
+void
+shard_pool::serve_(int task_fd, int result_fd, const task_fn& fn)
+{
+	// the coordinator's buffered output stays with the coordinator
+	std::ostringstream buf;
+	std::cout.rdbuf(buf.rdbuf());
+
+	uint32_t task;
+	while(read_all(task_fd, &task, sizeof(task)))
+	{
+		buf.str("");
+		int status;
+		try
+		{
+			status = fn(task);
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "err; task " << task << ": " << e.what() << "\n";
+			status = 1;
+		}
+		std::string body = buf.str();
+		result_header h{task, status, body.size()};
+		if(!write_all(result_fd, &h, sizeof(h))
+		   || !write_all(result_fd, body.data(), body.size()))
+		{
+			break;
+		}
+	}
+	// without running the destructors of the coordinator's objects
+	::_exit(0);
+}
+
+int
+shard_pool::reap_(worker& w)
+{
+	::close(w.task_fd_);
+	::close(w.result_fd_);
+	int status = 0;
+	while(::waitpid(w.pid_, &status, 0) < 0 && errno == EINTR) { }
+	return status;
+}
+
+} // namespace warthog::util
@@ -0,0 +1,107 @@
+#ifndef WARTHOG_APP_SHARD_POOL_H
+#define WARTHOG_APP_SHARD_POOL_H
+
+// shard_pool.h
+//
+// Runs a list of tasks in a pool of forked worker processes, so that a
+// large sweep can use every core of a host and a crash loses only the
+// task that caused it. Each worker is a copy of the coordinator, taken
+// when it is forked, and solves a task by calling a function with the
+// task's number; the tasks themselves never cross process boundaries.
+//
+// The work queue is a pair of pipes per worker. The coordinator writes
+// the number of a task to an idle worker; the worker replies with the
+// task's exit status and everything the task wrote to std::cout. Results
+// are written out in task order as soon as all earlier tasks are done,
+// so the merged output is the same however many workers there are.
+//
+// A worker that dies is replaced. The task it was running is tried
+// again, up to a number of attempts, and then reported as failed. A task
+// that returns a non-zero status is not tried again.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace warthog::util
+{
+
+class shard_pool
+{
+public:
+	// solves task @param task, writing its results to std::cout; returns
+	// an exit status, 0 if the task succeeded
+	using task_fn = std::function<int(uint32_t task)>;
+
+	// @param attempts is the number of times a task is started before a
+	// crash of its worker is reported as a failure
+	shard_pool(uint32_t workers, uint32_t attempts = 3);
+	shard_pool(const shard_pool&) = delete;
+	~shard_pool();
+
+	shard_pool&
+	operator=(const shard_pool&)
+	    = delete;
+
+	// solve tasks 0 to @param num_tasks - 1 and write their results to
+	// @param out, in order. returns 0 if every task succeeded, else the
+	// status of the first task that did not.
+	int
+	run(uint32_t num_tasks, const task_fn& fn, std::ostream& out);
+
+	// workers that died; each is replaced while there are tasks left
+	uint32_t
+	get_restarts() const noexcept
+	{
+		return restarts_;
+	}
+
+	// tasks that returned a non-zero status or ran out of attempts
+	uint32_t
+	get_failed() const noexcept
+	{
+		return failed_;
+	}
+
+private:
+	static constexpr uint32_t IDLE = UINT32_MAX;
+
+	struct worker
+	{
+		pid_t pid_;
+		int task_fd_;   // coordinator writes task numbers
+		int result_fd_; // coordinator reads results
+		uint32_t task_; // IDLE if none
+	};
+
+	uint32_t num_workers_;
+	uint32_t attempts_;
+	uint32_t restarts_;
+	uint32_t failed_;
+	std::vector<worker> workers_;
+
+	// fork a worker; false if it could not be started
+	bool
+	spawn_(const task_fn& fn);
+
+	// the loop of a worker process; does not return
+	[[noreturn]] void
+	serve_(int task_fd, int result_fd, const task_fn& fn);
+
+	// close the pipes of worker @param w and wait for it to exit;
+	// returns its wait status
+	int
+	reap_(worker& w);
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_APP_SHARD_POOL_H
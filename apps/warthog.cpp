@@ -8,30 +8,52 @@
 //
 
 #include <warthog/constants.h>
+#include <warthog/domain/grid_components.h>
 #include <warthog/domain/gridmap.h>
 #include <warthog/domain/labelled_gridmap.h>
+#include <warthog/domain/map_stats.h>
+#include <warthog/domain/move_table.h>
 #include <warthog/heuristic/manhattan_heuristic.h>
 #include <warthog/heuristic/octile_heuristic.h>
 #include <warthog/heuristic/zero_heuristic.h>
+#include <warthog/search/batch_search.h>
+#include <warthog/search/cost_predictor.h>
+#include <warthog/search/beam_search.h>
+#include <warthog/search/fringe_search.h>
 #include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/lss_lrta_search.h>
 #include <warthog/search/search.h>
+#include <warthog/search/sma_star_search.h>
 #include <warthog/search/unidirectional_search.h>
 #include <warthog/search/vl_gridmap_expansion_policy.h>
+#include <warthog/util/lazy_pqueue.h>
+#include <warthog/util/locality_order.h>
+#include <warthog/util/map_cache.h>
+#include <warthog/util/packed_pqueue.h>
 #include <warthog/util/pqueue.h>
+#include <warthog/util/query_log.h>
 #include <warthog/util/scenario_manager.h>
 #include <warthog/util/timer.h>
+#include <warthog/util/tuning_profile.h>
 
 #include "cfg.h"
+#include "query_server.h"
+#include "shard_pool.h"
 #include <getopt.h>
 #include <warthog/config.h>
 
+#include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 
 // #include "time_constraints.h"
@@ -44,6 +66,70 @@ int checkopt = 0;
 int verbose = 0;
 // display program help on startup
 int print_help = 0;
+// weight on the heuristic; w > 1 gives weighted A*
+double weight = 1.0;
+// read legal moves from a precomputed per-cell table
+int movetable = 0;
+// solve instances in order of increasing predicted cost
+int spf = 0;
+// reorder instances within windows of this many, so that consecutive
+// searches cover nearby parts of the map; 0 to keep the order
+uint32_t locality = 0;
+// tuning profile to read or write; empty for the default of the map
+std::string profile;
+// the server reads and writes binary records instead of lines of text
+int binary = 0;
+// ids of the instances being run, in the scenario file; null if the
+// instances are those of the whole file
+const std::vector<uint32_t>* instance_ids = nullptr;
+// set in the worker processes of --procs, whose tasks cover part of the
+// instances each; the summary of a run over part of them is not printed
+bool shard_worker = false;
+
+// a gridmap and the indexes over it, which are built on first use
+struct resident_grid
+{
+	resident_grid(const char* filename) : map_(filename), moves_mem_(0) { }
+
+	warthog::domain::move_table*
+	moves()
+	{
+		std::call_once(moves_built_, [this] {
+			moves_     = std::make_unique<warthog::domain::move_table>(map_);
+			moves_mem_ = moves_->mem();
+		});
+		return moves_.get();
+	}
+
+	size_t
+	mem() const
+	{
+		return sizeof(*this) + map_.mem() + moves_mem_;
+	}
+
+	warthog::domain::gridmap map_;
+	std::unique_ptr<warthog::domain::move_table> moves_;
+	std::once_flag moves_built_;
+	std::atomic<size_t> moves_mem_;
+};
+
+// the log of --record; null if queries are not recorded
+std::unique_ptr<warthog::util::query_log_writer> record_log;
+
+// a recorder for the queries on @param map, to the log of --record; null
+// if queries are not recorded
+std::unique_ptr<warthog::util::query_recorder>
+make_recorder(const warthog::domain::gridmap& map, const std::string& mapname)
+{
+	if(!record_log) { return nullptr; }
+	return std::make_unique<warthog::util::query_recorder>(
+	    *record_log, mapname, map.header_width(), map.header_height());
+}
+
+// maps loaded so far, kept within --mapcache megabytes
+warthog::util::map_cache<resident_grid> grids(size_t(1024) << 20);
+warthog::util::map_cache<warthog::domain::vl_gridmap> vl_grids(
+    size_t(1024) << 20);
 
 void
 help(std::ostream& out)
@@ -66,19 +152,128 @@ help(std::ostream& out)
 	       "values in the scen file)\n"
 	    << "\t--verbose (optional; prints debugging info when compiled "
 	       "with debug symbols)\n"
+	    << "\t--beam [width] (optional; maximum size of the open list "
+	       "for beam search, default 1024)\n"
+	    << "\t--budget [nodes] (optional; maximum number of search nodes "
+	       "held in memory by sma, default 65536)\n"
+	    << "\t--weight [w] (optional; weight w >= 1 on the heuristic, "
+	       "for weighted A*; default 1)\n"
+	    << "\t--tiebreak [g|h|lifo|fifo] (optional; astar breaks f-ties "
+	       "by larger g, smaller h or insertion order, using packed "
+	       "integer keys)\n"
+	    << "\t--queue [packed|lazy] (optional; astar open list keyed on "
+	       "packed integers, with decrease-key or with lazy deletion; "
+	       "default packed)\n"
+	    << "\t--lookahead [nodes] (optional; expansions per step of the "
+	       "real-time search lrta, default 64)\n"
+	    << "\t--lanes [n] (optional; queries interleaved at a time by "
+	       "astar_batch, default 8)\n"
+	    << "\t--movetable (optional; astar and astar_batch read the legal "
+	       "moves of each cell from a table precomputed at load)\n"
+	    << "\t--profile [file] (optional; tuning profile written by tune "
+	       "and read by auto, default [map file].profile)\n"
+	    << "\t--spf (optional; astar and astar_batch solve instances in "
+	       "order of increasing predicted cost, using the cost model of "
+	       "the profile)\n"
+	    << "\t--locality [n] (optional; astar and astar_batch reorder each "
+	       "n consecutive instances so that consecutive searches cover "
+	       "nearby parts of the map; results are printed in the original "
+	       "order)\n"
+	    << "\t--mapcache [MB] (optional; memory for maps kept loaded "
+	       "between runs, default 1024)\n"
+	    << "\t--record [file] (optional; astar, auto, astar_lazy, "
+	       "astar_batch, astar4c, gbfs and dijkstra write each query they "
+	       "solve, and what was observed, to a query log)\n"
+	    << "\t--procs [n] (optional; solve the instances in n worker "
+	       "processes, a task of up to --chunk instances of one map at a "
+	       "time; --scen may then name several files)\n"
+	    << "\t--chunk [n] (optional; instances per task of --procs, default "
+	       "1000)\n"
+	    << "\t--retries [n] (optional; times a task of --procs is tried "
+	       "again after its worker dies, default 2)\n"
+	    << "\t--shard [k/n] (optional; with --procs, solve only every nth "
+	       "task from the kth, counting from 0, to split a run across "
+	       "hosts)\n"
 	    << "Invoking the program this way solves all instances in [scen "
 	       "file] with algorithm [alg]\n"
+	    << "If the instances are on several maps, and --map is not given, "
+	       "they are solved one map at a time\n"
 	    << "Currently recognised values for [alg]:\n"
-	    << "\tastar, astar_wgm, astar4c, dijkstra\n";
+	    << "\tastar, astar_wgm, astar4c, dijkstra, beam, beam_layered, sma,\n"
+	    << "\tlrta, gbfs, astar_lazy, fringe, astar_batch, auto\n"
+	    << "Use --alg fringe_vs_astar to run fringe search and astar on "
+	       "each instance, head-to-head, and print totals for both\n";
+
+	out << "\nThe following are valid parameters for TUNING:\n"
+	    << "\t--alg tune (required)\n"
+	    << "\t--map [map file] (required, unless given by --scen)\n"
+	    << "\t--scen [scen file] (optional; instances to time, instead of "
+	       "generated ones)\n"
+	    << "\t--samples [n] (optional; number of instances to generate, "
+	       "default 100)\n"
+	    << "\t--profile [file] (optional; where to write the profile)\n"
+	    << "Invoking the program this way times astar with each open list, "
+	       "heuristic evaluation\n"
+	    << "and move table setting on the instances, and writes the "
+	       "fastest configuration\n"
+	    << "and the statistics of the map to a profile, with a model of "
+	       "query costs fitted\n"
+	    << "to that configuration. --alg auto solves instances with astar "
+	       "configured by the\n"
+	    << "profile of their map; --spf orders them by the cost model.\n";
+
+	out << "\nThe following are valid parameters for SERVING queries:\n"
+	    << "\t--alg serve (required)\n"
+	    << "\t--map [map file] (required, unless given by --scen)\n"
+	    << "\t--socket [path] (optional; accept clients on a Unix domain "
+	       "socket instead of stdin/stdout)\n"
+	    << "\t--workers [n] (optional; queries solved at once, default one "
+	       "per hardware thread)\n"
+	    << "\t--binary (optional; fixed-size binary records instead of "
+	       "lines of text)\n"
+	    << "\t--movetable (optional; as for astar)\n"
+	    << "\t--locality [n] (optional; queries read together are reordered "
+	       "n at a time, as for astar)\n"
+	    << "Invoking the program this way keeps the map loaded and answers "
+	       "queries \"id sx sy gx gy\"\n"
+	    << "with \"id cost plen expanded nanos\" as each is solved; see "
+	       "apps/query_server.h.\n"
+	    << "With --record [file] the queries are written to a query log, "
+	       "as for astar.\n";
+
+	out << "\nThe following are valid parameters for REPLAYING queries:\n"
+	    << "\t--alg replay (required)\n"
+	    << "\t--log [file] (required; a query log written with --record)\n"
+	    << "\t--speed [original|max] (optional; start queries at the times "
+	       "they were recorded, or back to back; default original)\n"
+	    << "\t--tolerance [percent] (optional; how much slower than the "
+	       "recording the replay may be, default 10)\n"
+	    << "\t--movetable (optional; as for astar)\n"
+	    << "Invoking the program this way solves the logged queries again "
+	       "with astar, prints\n"
+	    << "what was observed next to what was recorded, and fails if a "
+	       "cost differs (4) or\n"
+	    << "the replay is slower than the tolerance allows (5).\n";
 }
 
+// with @param w > 1 the check is that the solution is w-suboptimal
 bool
 check_optimality(
-    warthog::search::solution& sol, warthog::util::experiment* exp)
+    warthog::search::solution& sol, warthog::util::experiment* exp,
+    double w = 1.0)
 {
+	// path costs are summed one edge at a time in cost_t; allow for the
+	// rounding error which accumulates along the path
+	double rounding
+	    = sol.path_.size() * warthog::COST_EPSILON * exp->distance();
 	uint32_t precision = 2;
-	double epsilon     = (1.0 / (int)pow(10, precision)) / 2;
+	double epsilon     = (1.0 / (int)pow(10, precision)) / 2 + rounding;
 	double delta       = fabs(sol.sum_of_edge_costs_ - exp->distance());
+	if(w > 1.0 && sol.sum_of_edge_costs_ >= exp->distance()
+	   && sol.sum_of_edge_costs_ <= w * exp->distance() + 2 * epsilon)
+	{
+		return true;
+	}
 
 	if(fabs(delta - epsilon) > epsilon)
 	{
@@ -104,21 +299,163 @@ check_optimality(
 	return true;
 }
 
+// prints one row per solved instance and tracks solution cost relative
+// to the optimal cost in the scen file
+struct result_summary
+{
+	double total_cost = 0, total_opt = 0, max_ratio = 1;
+	uint32_t unsolved = 0;
+
+	void
+	print_header(std::ostream& out)
+	{
+		// runs over several maps share one table
+		static bool printed = false;
+		if(printed) { return; }
+		printed = true;
+		out << "id\talg\texpanded\tgenerated\treopen\tsurplus\theapops"
+		    << "\tnanos\tplen\tpcost\tscost\tmap\tpruned\n";
+	}
+
+	void
+	add(uint32_t i, const std::string& alg_name,
+	    warthog::search::solution& sol, warthog::util::experiment* exp,
+	    warthog::util::scenario_manager& scenmgr, std::ostream& out)
+	{
+		uint32_t id = instance_ids ? (*instance_ids)[i] : i;
+		out << id << "\t" << alg_name << "\t" << sol.met_.nodes_expanded_
+		    << "\t" << sol.met_.nodes_generated_ << "\t"
+		    << sol.met_.nodes_reopen_ << "\t" << sol.met_.nodes_surplus_
+		    << "\t" << sol.met_.heap_ops_ << "\t"
+		    << sol.met_.time_elapsed_nano_.count() << "\t"
+		    << (sol.path_.size() - 1) << "\t" << sol.sum_of_edge_costs_ << "\t"
+		    << exp->distance() << "\t" << scenmgr.last_file_loaded() << "\t"
+		    << sol.met_.nodes_pruned_ << std::endl;
+
+		if(sol.sum_of_edge_costs_ == warthog::COST_MAX) { unsolved++; }
+		else if(exp->distance() > 0)
+		{
+			total_cost += sol.sum_of_edge_costs_;
+			total_opt  += exp->distance();
+			max_ratio   = std::max(
+			    max_ratio, sol.sum_of_edge_costs_ / exp->distance());
+		}
+	}
+
+	void
+	print(std::ostream& out)
+	{
+		out << "cost ratio: " << (total_opt > 0 ? total_cost / total_opt : 1.0)
+		    << " max: " << max_ratio << " unsolved: " << unsolved << "\n";
+	}
+};
+
+// true if two path costs are equal, up to the rounding error of cost_t
+// over a path of @param plen states
+bool
+same_cost(double a, double b, size_t plen)
+{
+	if(a == warthog::COST_MAX || b == warthog::COST_MAX) { return a == b; }
+	return fabs(a - b) <= 1e-6 + plen * warthog::COST_EPSILON * std::max(a, b);
+}
+
+// the tuning profile of @param map: from --profile, or else from the
+// default location for @param mapname. defaults if there is no profile
+// or it was made for a different map.
+warthog::util::tuning_profile
+find_profile(const warthog::domain::gridmap& map, const std::string& mapname)
+{
+	std::string file = profile.empty()
+	    ? warthog::util::profile_filename(mapname).string()
+	    : profile;
+	warthog::util::tuning_profile prof;
+	if(!std::filesystem::exists(file))
+	{
+		std::cerr << "no tuning profile at " << file << "; using defaults\n";
+	}
+	else if(prof.load(file.c_str()) && !prof.matches(map))
+	{
+		std::cerr << "tuning profile " << file
+		          << " was made for a different map; using defaults\n";
+		prof = warthog::util::tuning_profile();
+	}
+	return prof;
+}
+
+// the order in which to solve the instances of @param scenmgr: as given
+// or, with --spf, by increasing predicted time; then, with --locality,
+// for locality within windows of that order
+std::vector<uint32_t>
+schedule(
+    const warthog::domain::gridmap& map, const std::string& mapname,
+    warthog::util::scenario_manager& scenmgr)
+{
+	std::vector<uint32_t> order(scenmgr.num_experiments());
+	std::iota(order.begin(), order.end(), 0);
+	if(spf)
+	{
+		warthog::search::cost_predictor predictor(map);
+		predictor.set_model(find_profile(map, mapname).model_);
+		std::vector<double> cost(order.size());
+		for(uint32_t i = 0; i < order.size(); i++)
+		{
+			warthog::util::experiment* exp = scenmgr.get_experiment(i);
+			cost[i] = predictor.nanos(predictor.features(
+			    exp->startx(), exp->starty(), exp->goalx(), exp->goaly()));
+		}
+		std::stable_sort(
+		    order.begin(), order.end(),
+		    [&](uint32_t a, uint32_t b) { return cost[a] < cost[b]; });
+	}
+	if(locality)
+	{
+		std::vector<uint64_t> keys(order.size());
+		for(uint32_t i = 0; i < order.size(); i++)
+		{
+			warthog::util::experiment* exp = scenmgr.get_experiment(i);
+			keys[i]                        = warthog::util::locality_key(
+			    exp->startx(), exp->starty(), exp->goalx(), exp->goaly());
+		}
+		warthog::util::locality_order(order, keys, locality);
+	}
+	return order;
+}
+
 template<typename Search>
 int
 run_experiments(
     Search& algo, std::string alg_name,
     warthog::util::scenario_manager& scenmgr, bool verbose, bool checkopt,
-    std::ostream& out)
+    std::ostream& out, const std::vector<uint32_t>* order = nullptr,
+    warthog::util::query_recorder* recorder = nullptr)
 {
 	warthog::search::search_parameters par;
 	warthog::search::solution sol;
 	auto* expander = algo.get_expander();
 	if(expander == nullptr) return 1;
-	out << "id\talg\texpanded\tgenerated\treopen\tsurplus\theapops"
-	    << "\tnanos\tplen\tpcost\tscost\tmap\n";
-	for(unsigned int i = 0; i < scenmgr.num_experiments(); i++)
+	par.set_w_admissibility(weight);
+	par.set_recorder(recorder);
+
+	// the time from the first instance to the end of each, summed; this
+	// is what the order of the instances changes
+	uint64_t elapsed = 0;
+	double completion = 0;
+	result_summary summary;
+	summary.print_header(out);
+
+	// results are printed in the order of the instances, whatever order
+	// they are solved in
+	std::vector<std::string> lines(order ? scenmgr.num_experiments() : 0);
+	std::ostringstream line;
+	auto flush = [&]() {
+		for(const std::string& l : lines)
+		{
+			out << l;
+		}
+	};
+	for(unsigned int k = 0; k < scenmgr.num_experiments(); k++)
 	{
+		uint32_t i                     = order ? (*order)[k] : k;
 		warthog::util::experiment* exp = scenmgr.get_experiment(i);
 
 		warthog::pack_id startid
@@ -129,54 +466,603 @@ run_experiments(
 		sol.reset();
 
 		algo.get_path(&pi, &par, &sol);
+		elapsed    += sol.met_.time_elapsed_nano_.count();
+		completion += elapsed;
 
-		out << i << "\t" << alg_name << "\t" << sol.met_.nodes_expanded_
-		    << "\t" << sol.met_.nodes_generated_ << "\t"
-		    << sol.met_.nodes_reopen_ << "\t" << sol.met_.nodes_surplus_
-		    << "\t" << sol.met_.heap_ops_ << "\t"
-		    << sol.met_.time_elapsed_nano_.count() << "\t"
-		    << (sol.path_.size() - 1) << "\t" << sol.sum_of_edge_costs_ << "\t"
-		    << exp->distance() << "\t" << scenmgr.last_file_loaded()
-		    << std::endl;
+		if(order)
+		{
+			line.str("");
+			summary.add(i, alg_name, sol, exp, scenmgr, line);
+			lines[i] = line.str();
+		}
+		else { summary.add(i, alg_name, sol, exp, scenmgr, out); }
+		if(checkopt && !check_optimality(sol, exp, weight))
+		{
+			flush();
+			return 4;
+		}
+	}
+	flush();
+	if(!shard_worker)
+	{
+		summary.print(std::cerr);
+		std::cerr << "mean completion nanos: "
+		          << completion / scenmgr.num_experiments() << "\n";
+	}
+	return 0;
+}
+
+template<
+    class Q = warthog::util::pqueue_min,
+    warthog::search::heuristic_evaluation HE
+    = warthog::search::heuristic_evaluation::eager>
+int
+run_astar(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::domain::move_table* moves
+	    = movetable ? resident->moves() : nullptr;
+	warthog::search::gridmap_expansion_policy expander(
+	    &map, false, moves);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	Q open;
+
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, Q,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::any,
+	    warthog::search::feasibility_criteria::until_exhaustion,
+	    warthog::search::reopen_policy::no, HE>
+	    astar(&heuristic, &expander, &open);
+
+	// results are buffered only if the instances are reordered
+	std::vector<uint32_t> order;
+	if(spf || locality) { order = schedule(map, mapname, scenmgr); }
+	auto recorder = make_recorder(map, mapname);
+
+	int ret = run_experiments(
+	    astar, alg_name, scenmgr, verbose, checkopt, std::cout,
+	    order.empty() ? nullptr : &order, recorder.get());
+	if(ret != 0)
+	{
+		std::cerr << "run_experiments error code " << ret << std::endl;
+		return ret;
+	}
+	std::cerr << "done. total memory: " << astar.mem() + scenmgr.mem() << "\n";
+	return 0;
+}
+
+// the configurations of astar are instantiated by the helpers below.
+// each calls @param fn.operator()<Q, HE>() with the open list Q and the
+// heuristic evaluation HE named by a tuning profile.
+template<
+    warthog::search::heuristic_evaluation HE,
+    template<warthog::search::tie_breaking> class Q, class Fn>
+auto
+with_tiebreak(const std::string& tiebreak, Fn& fn)
+{
+	using warthog::search::tie_breaking;
+	if(tiebreak == "h")
+	{
+		return fn.template operator()<Q<tie_breaking::smaller_h>, HE>();
+	}
+	if(tiebreak == "lifo")
+	{
+		return fn.template operator()<Q<tie_breaking::lifo>, HE>();
+	}
+	if(tiebreak == "fifo")
+	{
+		return fn.template operator()<Q<tie_breaking::fifo>, HE>();
+	}
+	return fn.template operator()<Q<tie_breaking::larger_g>, HE>();
+}
+
+template<warthog::search::heuristic_evaluation HE, class Fn>
+auto
+with_queue(const warthog::util::tuning_profile& prof, Fn& fn)
+{
+	if(prof.queue_ == "packed")
+	{
+		return with_tiebreak<HE, warthog::util::packed_pqueue>(
+		    prof.tiebreak_, fn);
+	}
+	if(prof.queue_ == "lazy")
+	{
+		return with_tiebreak<HE, warthog::util::lazy_pqueue>(
+		    prof.tiebreak_, fn);
+	}
+	return fn.template operator()<warthog::util::pqueue_min, HE>();
+}
+
+template<class Fn>
+auto
+with_astar_config(const warthog::util::tuning_profile& prof, Fn&& fn)
+{
+	using warthog::search::heuristic_evaluation;
+	if(prof.lazy_h_)
+	{
+		return with_queue<heuristic_evaluation::lazy>(prof, fn);
+	}
+	return with_queue<heuristic_evaluation::eager>(prof, fn);
+}
+
+// astar configured by the tuning profile of @param mapname, if there is
+// one for this map, and as plain astar otherwise
+int
+run_astar_auto(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name)
+{
+	warthog::util::tuning_profile prof;
+	{
+		auto resident = grids.get(mapname);
+		prof          = find_profile(resident->map_, mapname);
+	}
+	std::cerr << "configuration: " << prof.name() << "\n";
+
+	movetable = prof.movetable_;
+	return with_astar_config(
+	    prof, [&]<class Q, warthog::search::heuristic_evaluation HE>() {
+		    return run_astar<Q, HE>(scenmgr, mapname, alg_name);
+	    });
+}
+
+// total search time, in nanoseconds, of astar with open list Q and
+// heuristic evaluation HE over every instance of @param scenmgr. the
+// fastest of @param reps runs is taken. the metrics of each instance, in
+// the last run, are written to @param met if given.
+template<class Q, warthog::search::heuristic_evaluation HE>
+uint64_t
+time_astar(
+    warthog::domain::gridmap& map, const warthog::domain::move_table* moves,
+    warthog::util::scenario_manager& scenmgr, uint32_t reps,
+    std::vector<warthog::search::search_metrics>* met = nullptr)
+{
+	warthog::search::gridmap_expansion_policy expander(&map, false, moves);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	Q open;
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, Q,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::any,
+	    warthog::search::feasibility_criteria::until_exhaustion,
+	    warthog::search::reopen_policy::no, HE>
+	    astar(&heuristic, &expander, &open);
 
-		if(checkopt)
+	warthog::search::search_parameters par;
+	warthog::search::solution sol;
+	uint64_t best = UINT64_MAX;
+	for(uint32_t rep = 0; rep < reps; rep++)
+	{
+		uint64_t total = 0;
+		for(unsigned int i = 0; i < scenmgr.num_experiments(); i++)
 		{
-			if(!check_optimality(sol, exp)) return 4;
+			warthog::util::experiment* exp = scenmgr.get_experiment(i);
+			warthog::search::problem_instance pi(
+			    expander.get_pack(exp->startx(), exp->starty()),
+			    expander.get_pack(exp->goalx(), exp->goaly()));
+			sol.reset();
+			astar.get_path(&pi, &par, &sol);
+			total += sol.met_.time_elapsed_nano_.count();
+			if(met && rep + 1 == reps) { met->push_back(sol.met_); }
 		}
+		best = std::min(best, total);
+	}
+	return best;
+}
+
+// time every configuration of astar on the instances of @param scenmgr
+// and write the fastest, with the statistics of the map and a cost model
+// fitted to it, to the tuning profile
+int
+run_tune(
+    warthog::util::scenario_manager& scenmgr, std::string mapname)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::domain::grid_components components(map);
+	warthog::domain::map_stats stats(map, components);
+	warthog::domain::move_table& moves = *resident->moves();
+	std::cerr << "map " << mapname << ": " << stats.width_ << "x"
+	          << stats.height_ << ", obstacle density "
+	          << stats.obstacle_density_ << ", " << stats.components_
+	          << " components (largest " << stats.largest_share_
+	          << "), corridor ratio " << stats.corridor_ratio_ << "\n";
+
+	std::vector<warthog::util::tuning_profile> configs;
+	for(bool lazy_h : {false, true})
+		for(bool table : {false, true})
+		{
+			for(std::string queue : {"binary", "packed", "lazy"})
+				for(std::string tiebreak : {"g", "h"})
+				{
+					if(queue == "binary" && tiebreak != "g") { continue; }
+					warthog::util::tuning_profile c;
+					c.queue_     = queue;
+					c.tiebreak_  = tiebreak;
+					c.lazy_h_    = lazy_h;
+					c.movetable_ = table;
+					configs.push_back(c);
+				}
+		}
+
+	std::vector<uint64_t> nanos;
+	std::cout << "config\tnanos\n";
+	for(auto& c : configs)
+	{
+		nanos.push_back(with_astar_config(
+		    c, [&]<class Q, warthog::search::heuristic_evaluation HE>() {
+			    return time_astar<Q, HE>(
+			        map, c.movetable_ ? &moves : nullptr, scenmgr, 3);
+		    }));
+		std::cout << c.name() << "\t" << nanos.back() << std::endl;
 	}
 
+	size_t best = std::min_element(nanos.begin(), nanos.end()) - nanos.begin();
+	warthog::util::tuning_profile prof = configs[best];
+	prof.stats_                        = stats;
+
+	// fit the cost model to the fastest configuration
+	std::vector<warthog::search::search_metrics> met;
+	with_astar_config(
+	    prof, [&]<class Q, warthog::search::heuristic_evaluation HE>() {
+		    return time_astar<Q, HE>(
+		        map, prof.movetable_ ? &moves : nullptr, scenmgr, 1, &met);
+	    });
+	warthog::search::cost_predictor predictor(map);
+	std::vector<warthog::search::query_features> features;
+	std::vector<double> expanded, query_nanos;
+	for(uint32_t i = 0; i < scenmgr.num_experiments(); i++)
+	{
+		warthog::util::experiment* exp = scenmgr.get_experiment(i);
+		features.push_back(predictor.features(
+		    exp->startx(), exp->starty(), exp->goalx(), exp->goaly()));
+		expanded.push_back(met[i].nodes_expanded_);
+		query_nanos.push_back(met[i].time_elapsed_nano_.count());
+	}
+	predictor.fit(features, expanded, query_nanos);
+	prof.model_ = predictor.get_model();
+
+	std::string file = profile.empty()
+	    ? warthog::util::profile_filename(mapname).string()
+	    : profile;
+	std::ofstream out(file);
+	if(!out)
+	{
+		std::cerr << "err; cannot write tuning profile " << file << "\n";
+		return 1;
+	}
+	prof.save(out);
+	out << "# search nanos over " << scenmgr.num_experiments()
+	    << " instances, fastest of 3 runs\n";
+	for(size_t i = 0; i < configs.size(); i++)
+	{
+		out << "# " << configs[i].name() << " " << nanos[i] << "\n";
+	}
+	std::cerr << "fastest: " << prof.name() << "; profile written to "
+	          << file << "\n";
 	return 0;
 }
 
+// answer queries on @param mapname read from stdin, or from the clients
+// of a Unix domain socket at @param socket, with @param workers threads
 int
-run_astar(
+run_server(std::string mapname, std::string socket, uint32_t workers)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::domain::move_table* moves
+	    = movetable ? resident->moves() : nullptr;
+	auto recorder = make_recorder(map, mapname);
+	warthog::util::query_server server(
+	    map, moves, workers, binary, locality);
+	server.set_recorder(recorder.get());
+	std::cerr << "serving " << mapname << " with " << workers << " workers"
+	          << (socket.empty() ? " on stdin" : " on " + socket) << "\n";
+	if(socket.empty())
+	{
+		server.serve(STDIN_FILENO, STDOUT_FILENO);
+		return 0;
+	}
+	return server.listen(socket) ? 0 : 1;
+}
+
+// re-run the queries of the query log @param logfile with astar, at the
+// pace they were recorded if @param paced or else back to back, and
+// compare what is observed with the recording. costs must match; the
+// time of the replay must be within @param tolerance of the recording.
+int
+run_replay(const std::string& logfile, bool paced, double tolerance)
+{
+	struct replayer
+	{
+		replayer(std::shared_ptr<resident_grid> grid)
+		    : grid_(grid),
+		      expander_(
+		          &grid->map_, false, movetable ? grid->moves() : nullptr),
+		      heuristic_(grid->map_.width(), grid->map_.height()),
+		      astar_(&heuristic_, &expander_, &open_)
+		{ }
+
+		std::shared_ptr<resident_grid> grid_;
+		warthog::search::gridmap_expansion_policy expander_;
+		warthog::heuristic::octile_heuristic heuristic_;
+		warthog::util::pqueue_min open_;
+		warthog::search::unidirectional_search<
+		    warthog::heuristic::octile_heuristic,
+		    warthog::search::gridmap_expansion_policy>
+		    astar_;
+	};
+
+	std::unique_ptr<warthog::util::query_log_reader> log;
+	try
+	{
+		log = std::make_unique<warthog::util::query_log_reader>(
+		    logfile.c_str());
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "err; " << e.what() << "\n";
+		return 1;
+	}
+
+	std::vector<std::unique_ptr<replayer>> replayers; // by map number
+	warthog::search::search_parameters par;
+	warthog::search::solution sol;
+	warthog::util::query_record r;
+	uint64_t queries = 0, cost_diffs = 0, expanded_diffs = 0;
+	uint64_t recorded = 0, replayed = 0;
+	std::vector<double> ratios;
+	std::cout << "id\tmap\texpanded\trec_expanded\tnanos\trec_nanos\tcost"
+	          << "\trec_cost\n";
+	auto begin = std::chrono::steady_clock::now();
+	while(true)
+	{
+		try
+		{
+			if(!log->next(r)) { break; }
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "err; " << e.what() << " after " << queries
+			          << " queries\n";
+			return 1;
+		}
+		if(r.map_ >= replayers.size()) { replayers.resize(r.map_ + 1); }
+		const warthog::util::query_log_map& m = log->maps()[r.map_];
+		if(!replayers[r.map_])
+		{
+			replayers[r.map_] = std::make_unique<replayer>(grids.get(m.name_));
+			const auto& map = replayers[r.map_]->grid_->map_;
+			if(map.header_width() != m.width_
+			   || map.header_height() != m.height_)
+			{
+				std::cerr << "err; map " << m.name_
+				          << " is not the size it was when recorded\n";
+				return 1;
+			}
+		}
+		replayer& rp = *replayers[r.map_];
+
+		if(paced)
+		{
+			std::this_thread::sleep_until(
+			    begin + std::chrono::nanoseconds(r.time_));
+		}
+		warthog::search::problem_instance pi(
+		    warthog::pack_id{r.start_}, warthog::pack_id{r.target_});
+		par.set_max_expansions_cutoff(r.exp_cutoff_);
+		par.set_w_admissibility(r.weight_);
+		sol.reset();
+		rp.astar_.get_path(&pi, &par, &sol);
+
+		uint64_t nanos = sol.met_.time_elapsed_nano_.count();
+		std::cout << queries << "\t" << m.name_ << "\t"
+		          << sol.met_.nodes_expanded_ << "\t" << r.expanded_ << "\t"
+		          << nanos << "\t" << r.nanos_ << "\t"
+		          << sol.sum_of_edge_costs_ << "\t" << r.cost_ << "\n";
+		if(!same_cost(sol.sum_of_edge_costs_, r.cost_, sol.path_.size()))
+		{
+			cost_diffs++;
+		}
+		if(sol.met_.nodes_expanded_ != r.expanded_) { expanded_diffs++; }
+		recorded += r.nanos_;
+		replayed += nanos;
+		ratios.push_back((double)(nanos + 1) / (r.nanos_ + 1));
+		queries++;
+	}
+
+	auto quantile = [&ratios](double q) {
+		if(ratios.empty()) { return 1.0; }
+		size_t k = std::min(ratios.size() - 1, (size_t)(q * ratios.size()));
+		std::nth_element(ratios.begin(), ratios.begin() + k, ratios.end());
+		return ratios[k];
+	};
+	double ratio = recorded ? (double)replayed / recorded : 1.0;
+	std::cerr << "replayed " << queries << " queries on "
+	          << log->maps().size() << " maps; cost differences "
+	          << cost_diffs << ", expansion differences " << expanded_diffs
+	          << "\nsearch nanos: recorded " << recorded << ", replayed "
+	          << replayed << " (x" << ratio << "); per query x"
+	          << quantile(0.5) << " median, x" << quantile(0.9) << " p90, x"
+	          << quantile(0.99) << " p99\n";
+	if(cost_diffs) { return 4; }
+	if(ratio > 1 + tolerance)
+	{
+		std::cerr << "err; replay is slower than the recording by more than "
+		          << tolerance * 100 << "%\n";
+		return 5;
+	}
+	return 0;
+}
+
+// astar over all instances at once, interleaving @param lanes queries
+// at a time. each lane has its own expansion policy over the same map.
+int
+run_astar_batch(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name, uint32_t lanes)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	// lanes share the map, and the move table if there is one
+	warthog::domain::move_table* moves
+	    = movetable ? resident->moves() : nullptr;
+	std::vector<std::unique_ptr<warthog::search::gridmap_expansion_policy>>
+	    expanders;
+	std::vector<warthog::search::gridmap_expansion_policy*> lane_expanders;
+	for(uint32_t i = 0; i < lanes; i++)
+	{
+		expanders.push_back(
+		    std::make_unique<warthog::search::gridmap_expansion_policy>(
+		        &map, false, moves));
+		lane_expanders.push_back(expanders.back().get());
+	}
+	warthog::search::batch_search batch(&heuristic, lane_expanders);
+
+	std::vector<warthog::search::problem_instance> pis;
+	pis.reserve(scenmgr.num_experiments());
+	for(unsigned int i = 0; i < scenmgr.num_experiments(); i++)
+	{
+		warthog::util::experiment* exp = scenmgr.get_experiment(i);
+		pis.emplace_back(
+		    expanders[0]->get_pack(exp->startx(), exp->starty()),
+		    expanders[0]->get_pack(exp->goalx(), exp->goaly()), verbose);
+	}
+
+	auto recorder = make_recorder(map, mapname);
+	warthog::search::search_parameters par;
+	par.set_w_admissibility(weight);
+	par.set_recorder(recorder.get());
+	std::vector<warthog::search::solution> sols;
+	std::vector<uint32_t> order = schedule(map, mapname, scenmgr);
+	warthog::util::timer mytimer;
+	mytimer.start();
+	batch.get_paths(pis, &par, sols, &order);
+	uint64_t batch_nanos = mytimer.elapsed_time_nano().count();
+
+	result_summary summary;
+	summary.print_header(std::cout);
+	for(unsigned int i = 0; i < scenmgr.num_experiments(); i++)
+	{
+		warthog::util::experiment* exp = scenmgr.get_experiment(i);
+		summary.add(i, alg_name, sols[i], exp, scenmgr, std::cout);
+		if(checkopt && !check_optimality(sols[i], exp, weight))
+		{
+			std::cerr << "run_experiments error code 4" << std::endl;
+			return 4;
+		}
+	}
+	if(!shard_worker) { summary.print(std::cerr); }
+	std::cerr << "lanes: " << lanes << " batch nanos: " << batch_nanos << "\n";
+	std::cerr << "done. total memory: " << batch.mem() + scenmgr.mem() << "\n";
+	return 0;
+}
+
+int
+run_fringe(
     warthog::util::scenario_manager& scenmgr, std::string mapname,
     std::string alg_name)
 {
-	warthog::domain::gridmap map(mapname.c_str());
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
 	warthog::search::gridmap_expansion_policy expander(&map);
 	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
-	warthog::util::pqueue_min open;
 
-	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::fringe_search fringe(&heuristic, &expander);
 
 	int ret = run_experiments(
-	    astar, alg_name, scenmgr, verbose, checkopt, std::cout);
+	    fringe, alg_name, scenmgr, verbose, checkopt, std::cout);
 	if(ret != 0)
 	{
 		std::cerr << "run_experiments error code " << ret << std::endl;
 		return ret;
 	}
-	std::cerr << "done. total memory: " << astar.mem() + scenmgr.mem() << "\n";
+	std::cerr << "done. total memory: " << fringe.mem() + scenmgr.mem()
+	          << "\n";
 	return 0;
 }
 
+// solve every instance with fringe search and with astar, one after the
+// other, and report the total effort of each. both use the same map,
+// expansion policy and heuristic.
+int
+run_fringe_vs_astar(
+    warthog::util::scenario_manager& scenmgr, std::string mapname)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+
+	warthog::search::fringe_search fringe(&heuristic, &expander);
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+
+	warthog::search::search_parameters par;
+	par.set_w_admissibility(weight);
+	warthog::search::search_metrics fringe_met, astar_met;
+	uint64_t fringe_nanos = 0, astar_nanos = 0;
+	uint32_t fringe_wins = 0, mismatches = 0;
+	for(unsigned int i = 0; i < scenmgr.num_experiments(); i++)
+	{
+		warthog::util::experiment* exp = scenmgr.get_experiment(i);
+		warthog::pack_id startid
+		    = expander.get_pack(exp->startx(), exp->starty());
+		warthog::pack_id goalid
+		    = expander.get_pack(exp->goalx(), exp->goaly());
+
+		warthog::search::problem_instance pi1(startid, goalid, verbose);
+		warthog::search::solution sol1;
+		fringe.get_path(&pi1, &par, &sol1);
+
+		warthog::search::problem_instance pi2(startid, goalid, verbose);
+		warthog::search::solution sol2;
+		astar.get_path(&pi2, &par, &sol2);
+
+		fringe_met.nodes_expanded_  += sol1.met_.nodes_expanded_;
+		fringe_met.nodes_generated_ += sol1.met_.nodes_generated_;
+		fringe_nanos += sol1.met_.time_elapsed_nano_.count();
+		astar_met.nodes_expanded_  += sol2.met_.nodes_expanded_;
+		astar_met.nodes_generated_ += sol2.met_.nodes_generated_;
+		astar_nanos += sol2.met_.time_elapsed_nano_.count();
+		if(sol1.met_.time_elapsed_nano_ < sol2.met_.time_elapsed_nano_)
+		{
+			fringe_wins++;
+		}
+		if(!same_cost(
+		       sol1.sum_of_edge_costs_, sol2.sum_of_edge_costs_,
+		       sol1.path_.size()))
+		{
+			mismatches++;
+		}
+	}
+
+	std::cout << "alg\texpanded\tgenerated\tnanos\tfaster\n";
+	std::cout << "fringe\t" << fringe_met.nodes_expanded_ << "\t"
+	          << fringe_met.nodes_generated_ << "\t" << fringe_nanos << "\t"
+	          << fringe_wins << "\n";
+	std::cout << "astar\t" << astar_met.nodes_expanded_ << "\t"
+	          << astar_met.nodes_generated_ << "\t" << astar_nanos << "\t"
+	          << scenmgr.num_experiments() - fringe_wins << "\n";
+	std::cerr << "speedup: " << (double)astar_nanos / (double)fringe_nanos
+	          << " cost mismatches: " << mismatches << "\n";
+	return mismatches ? 4 : 0;
+}
+
 int
 run_astar4c(
     warthog::util::scenario_manager& scenmgr, std::string mapname,
     std::string alg_name)
 {
-	warthog::domain::gridmap map(mapname.c_str());
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
 	warthog::search::gridmap_expansion_policy expander(&map, true);
 	warthog::heuristic::manhattan_heuristic heuristic(
 	    map.width(), map.height());
@@ -184,8 +1070,11 @@ run_astar4c(
 
 	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
 
+	auto recorder = make_recorder(map, mapname);
+
 	int ret = run_experiments(
-	    astar, alg_name, scenmgr, verbose, checkopt, std::cout);
+	    astar, alg_name, scenmgr, verbose, checkopt, std::cout, nullptr,
+	    recorder.get());
 	if(ret != 0)
 	{
 		std::cerr << "run_experiments error code " << ret << std::endl;
@@ -195,20 +1084,55 @@ run_astar4c(
 	return 0;
 }
 
+int
+run_gbfs(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min_h open;
+
+	warthog::search::greedy_best_first_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy>
+	    gbfs(&heuristic, &expander, &open);
+
+	auto recorder = make_recorder(map, mapname);
+
+	// greedy search is unbounded suboptimal; --checkopt does not apply
+	int ret = run_experiments(
+	    gbfs, alg_name, scenmgr, verbose, false, std::cout, nullptr,
+	    recorder.get());
+	if(ret != 0)
+	{
+		std::cerr << "run_experiments error code " << ret << std::endl;
+		return ret;
+	}
+	std::cerr << "done. total memory: " << gbfs.mem() + scenmgr.mem() << "\n";
+	return 0;
+}
+
 int
 run_dijkstra(
     warthog::util::scenario_manager& scenmgr, std::string mapname,
     std::string alg_name)
 {
-	warthog::domain::gridmap map(mapname.c_str());
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
 	warthog::search::gridmap_expansion_policy expander(&map);
 	warthog::heuristic::zero_heuristic heuristic;
 	warthog::util::pqueue_min open;
 
 	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
 
+	auto recorder = make_recorder(map, mapname);
+
 	int ret = run_experiments(
-	    astar, alg_name, scenmgr, verbose, checkopt, std::cout);
+	    astar, alg_name, scenmgr, verbose, checkopt, std::cout, nullptr,
+	    recorder.get());
 	if(ret != 0)
 	{
 		std::cerr << "run_experiments error code " << ret << std::endl;
@@ -218,13 +1142,94 @@ run_dijkstra(
 	return 0;
 }
 
+template<warthog::search::beam_policy BP>
+int
+run_beam(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name, uint32_t beam_width)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::minmax_heap_min open;
+	warthog::util::minmax_heap_min next;
+
+	warthog::search::beam_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy,
+	    warthog::util::minmax_heap_min, warthog::search::dummy_listener, BP>
+	    beam(&heuristic, &expander, &open, beam_width, &next);
+
+	// beam search is suboptimal; --checkopt does not apply
+	int ret
+	    = run_experiments(beam, alg_name, scenmgr, verbose, false, std::cout);
+	if(ret != 0)
+	{
+		std::cerr << "run_experiments error code " << ret << std::endl;
+		return ret;
+	}
+	std::cerr << "done. total memory: " << beam.mem() + scenmgr.mem() << "\n";
+	return 0;
+}
+
+int
+run_sma(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name, size_t budget)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+
+	warthog::search::sma_star_search sma(&heuristic, &expander, budget);
+
+	int ret
+	    = run_experiments(sma, alg_name, scenmgr, verbose, checkopt, std::cout);
+	if(ret != 0)
+	{
+		std::cerr << "run_experiments error code " << ret << std::endl;
+		return ret;
+	}
+	std::cerr << "done. total memory: " << sma.mem() + scenmgr.mem() << "\n";
+	return 0;
+}
+
+int
+run_lrta(
+    warthog::util::scenario_manager& scenmgr, std::string mapname,
+    std::string alg_name, uint32_t lookahead)
+{
+	auto resident                 = grids.get(mapname);
+	warthog::domain::gridmap& map = resident->map_;
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+
+	warthog::search::lss_lrta_search lrta(
+	    &heuristic, &expander, &open, lookahead);
+
+	// real-time search is suboptimal; --checkopt does not apply
+	int ret
+	    = run_experiments(lrta, alg_name, scenmgr, verbose, false, std::cout);
+	if(ret != 0)
+	{
+		std::cerr << "run_experiments error code " << ret << std::endl;
+		return ret;
+	}
+	std::cerr << "done. total memory: " << lrta.mem() + scenmgr.mem() << "\n";
+	return 0;
+}
+
 int
 run_wgm_astar(
     warthog::util::scenario_manager& scenmgr, std::string mapname,
     std::string alg_name, std::string costfile)
 {
 	warthog::util::cost_table costs(costfile.c_str());
-	warthog::domain::vl_gridmap map(mapname.c_str());
+	auto resident                    = vl_grids.get(mapname);
+	warthog::domain::vl_gridmap& map = *resident;
 	warthog::search::vl_gridmap_expansion_policy expander(&map, costs);
 	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
 	warthog::util::pqueue_min open;
@@ -251,6 +1256,84 @@ run_wgm_astar(
 	return 0;
 }
 
+// instances of one map, from one scenario file, solved together by a
+// worker process of --procs
+struct shard_task
+{
+	std::unique_ptr<warthog::util::scenario_manager> instances_;
+	std::string mapfile_;
+	std::vector<uint32_t> ids_; // of the instances, in the scenario file
+};
+
+// split the instances of @param scenmgr, read from @param sfile, into
+// tasks of at most @param chunk instances of one map each. the map is
+// @param mapfile if given, else that named by the scenario file.
+bool
+add_shard_tasks(
+    warthog::util::scenario_manager& scenmgr, const std::string& sfile,
+    const std::string& mapfile, uint32_t chunk, std::vector<shard_task>& tasks)
+{
+	std::vector<std::vector<uint32_t>> ids;
+	std::vector<std::unique_ptr<warthog::util::scenario_manager>> groups;
+	if(mapfile.empty()) { groups = scenmgr.split_by_map(&ids); }
+	else
+	{
+		// all in one group
+		ids.emplace_back(scenmgr.num_experiments());
+		std::iota(ids[0].begin(), ids[0].end(), 0);
+		groups = scenmgr.split_by_size(std::max(1u, scenmgr.num_experiments()));
+	}
+
+	for(size_t g = 0; g < groups.size(); g++)
+	{
+		std::string file = mapfile.empty()
+		    ? warthog::util::find_map_filename(*groups[g], sfile).string()
+		    : mapfile;
+		if(file.empty())
+		{
+			std::cerr << "could not locate map file "
+			          << groups[g]->get_experiment(0)->map() << "\n";
+			return false;
+		}
+		auto chunks = groups[g]->split_by_size(chunk);
+		for(size_t c = 0; c < chunks.size(); c++)
+		{
+			auto first = ids[g].begin() + c * chunk;
+			auto last  = first + chunks[c]->num_experiments();
+			tasks.push_back({std::move(chunks[c]), file, {first, last}});
+		}
+	}
+	return true;
+}
+
+// solve @param tasks with @param run in @param procs worker processes and
+// print their results in the order of the tasks
+int
+run_sharded(
+    std::vector<shard_task>& tasks, uint32_t procs, uint32_t attempts,
+    const std::function<int(warthog::util::scenario_manager&, std::string)>&
+        run)
+{
+	// the workers are forked after the header is printed, and so do not
+	// print it again
+	result_summary().print_header(std::cout);
+	std::cout.flush();
+
+	warthog::util::shard_pool pool(procs, attempts);
+	int ret = pool.run(
+	    (uint32_t)tasks.size(),
+	    [&](uint32_t t) {
+		    instance_ids = &tasks[t].ids_;
+		    shard_worker = true;
+		    return run(*tasks[t].instances_, tasks[t].mapfile_);
+	    },
+	    std::cout);
+	std::cerr << "tasks: " << tasks.size() << ", failed "
+	          << pool.get_failed() << ", worker restarts "
+	          << pool.get_restarts() << "\n";
+	return ret;
+}
+
 } // namespace
 
 int
@@ -266,6 +1349,30 @@ main(int argc, char** argv)
 	       {"checkopt", no_argument, &checkopt, 1},
 	       {"verbose", no_argument, &verbose, 1},
 	       {"costs", required_argument, 0, 1},
+	       {"beam", required_argument, 0, 1},
+	       {"budget", required_argument, 0, 1},
+	       {"lookahead", required_argument, 0, 1},
+	       {"weight", required_argument, 0, 1},
+	       {"tiebreak", required_argument, 0, 1},
+	       {"queue", required_argument, 0, 1},
+	       {"lanes", required_argument, 0, 1},
+	       {"movetable", no_argument, &movetable, 1},
+	       {"profile", required_argument, 0, 1},
+	       {"spf", no_argument, &spf, 1},
+	       {"locality", required_argument, 0, 1},
+	       {"socket", required_argument, 0, 1},
+	       {"workers", required_argument, 0, 1},
+	       {"binary", no_argument, &binary, 1},
+	       {"samples", required_argument, 0, 1},
+	       {"mapcache", required_argument, 0, 1},
+	       {"record", required_argument, 0, 1},
+	       {"log", required_argument, 0, 1},
+	       {"speed", required_argument, 0, 1},
+	       {"tolerance", required_argument, 0, 1},
+	       {"procs", required_argument, 0, 1},
+	       {"chunk", required_argument, 0, 1},
+	       {"retries", required_argument, 0, 1},
+	       {"shard", required_argument, 0, 1},
 	       {0, 0, 0, 0}};
 
 	warthog::util::cfg cfg;
@@ -280,8 +1387,35 @@ main(int argc, char** argv)
 	std::string sfile = cfg.get_param_value("scen");
 	std::string alg   = cfg.get_param_value("alg");
 	// std::string gen = cfg.get_param_value("gen");
-	std::string mapfile  = cfg.get_param_value("map");
-	std::string costfile = cfg.get_param_value("costs");
+	std::string mapfile   = cfg.get_param_value("map");
+	std::string costfile  = cfg.get_param_value("costs");
+	std::string beamsize  = cfg.get_param_value("beam");
+	std::string budget    = cfg.get_param_value("budget");
+	std::string lookahead = cfg.get_param_value("lookahead");
+	std::string wstr      = cfg.get_param_value("weight");
+	std::string tiebreak  = cfg.get_param_value("tiebreak");
+	std::string queue     = cfg.get_param_value("queue");
+	std::string lanes     = cfg.get_param_value("lanes");
+	profile               = cfg.get_param_value("profile");
+	std::string samples   = cfg.get_param_value("samples");
+	std::string socket    = cfg.get_param_value("socket");
+	std::string workers   = cfg.get_param_value("workers");
+	std::string mapcache  = cfg.get_param_value("mapcache");
+	std::string window    = cfg.get_param_value("locality");
+	std::string record    = cfg.get_param_value("record");
+	std::string replaylog = cfg.get_param_value("log");
+	std::string speed     = cfg.get_param_value("speed");
+	std::string tolerance = cfg.get_param_value("tolerance");
+	std::string procs     = cfg.get_param_value("procs");
+	std::string chunk     = cfg.get_param_value("chunk");
+	std::string retries   = cfg.get_param_value("retries");
+	std::string shard     = cfg.get_param_value("shard");
+	// --procs can take several scenario files
+	std::vector<std::string> more_sfiles;
+	while(cfg.get_num_values("scen"))
+	{
+		more_sfiles.push_back(cfg.get_param_value("scen"));
+	}
 
 	// if(gen != "")
 	// {
@@ -292,23 +1426,286 @@ main(int argc, char** argv)
 	//     exit(0);
 	// }
 
-	// running experiments
-	if(alg == "" || sfile == "")
+	if(alg == "replay")
+	{
+		if(replaylog.empty() || (speed != "" && speed != "original"
+		                         && speed != "max"))
+		{
+			help(std::cout);
+			return 0;
+		}
+		return run_replay(
+		    replaylog, speed != "max",
+		    tolerance.empty() ? 0.1 : std::stod(tolerance) / 100);
+	}
+
+	// running experiments; tuning and serving need only a map
+	bool map_only = (alg == "tune" || alg == "serve") && sfile == ""
+	    && mapfile != "";
+	if(alg == "" || (sfile == "" && !map_only))
 	{
 		help(std::cout);
 		return 0;
 	}
 
+	if(!wstr.empty())
+	{
+		weight = std::stod(wstr);
+		if(!(weight >= 1.0))
+		{
+			std::cerr << "err; weight must be at least 1\n";
+			return 1;
+		}
+	}
+
+	if(!window.empty()) { locality = std::stoul(window); }
+
+	uint32_t nprocs = procs.empty() ? 0 : std::stoul(procs);
+	uint32_t size   = chunk.empty() ? 1000 : std::stoul(chunk);
+	uint32_t part   = 0;
+	uint32_t parts  = 1;
+	if(!procs.empty())
+	{
+		if(nprocs == 0 || size == 0)
+		{
+			std::cerr << "err; --procs and --chunk must be positive\n";
+			return 1;
+		}
+		if(map_only || alg == "tune" || alg == "serve"
+		   || alg == "fringe_vs_astar" || !record.empty())
+		{
+			std::cerr << "err; --procs runs the algorithms that solve "
+			             "instances, without --record\n";
+			return 1;
+		}
+		if(!shard.empty()
+		   && (std::sscanf(shard.c_str(), "%u/%u", &part, &parts) != 2
+		       || part >= parts))
+		{
+			std::cerr << "err; invalid shard: " << shard << "\n";
+			return 1;
+		}
+	}
+
+	if(!record.empty())
+	{
+		// the algorithms which log their queries
+		if(alg != "astar" && alg != "auto" && alg != "astar_lazy"
+		   && alg != "astar_batch" && alg != "astar4c" && alg != "gbfs"
+		   && alg != "dijkstra" && alg != "serve")
+		{
+			std::cerr << "err; --record runs astar, auto, astar_lazy, "
+			             "astar_batch, astar4c, gbfs, dijkstra or serve\n";
+			return 1;
+		}
+		try
+		{
+			record_log = std::make_unique<warthog::util::query_log_writer>(
+			    record.c_str());
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "err; " << e.what() << "\n";
+			return 1;
+		}
+	}
+
+	if(!mapcache.empty())
+	{
+		size_t budget = std::stoull(mapcache) << 20;
+		grids.set_budget(budget);
+		vl_grids.set_budget(budget);
+	}
+
 	// load up the instances
 	warthog::util::scenario_manager scenmgr;
-	scenmgr.load_scenario(sfile.c_str());
+	if(!map_only) { scenmgr.load_scenario(sfile.c_str()); }
 
-	if(scenmgr.num_experiments() == 0)
+	if(scenmgr.num_experiments() == 0 && !map_only)
 	{
 		std::cerr << "err; scenario file does not contain any instances\n";
 		return 1;
 	}
 
+	// the algorithm of --alg on the instances of @param scenmgr, all of
+	// which are on @param mapfile
+	auto run = [&](warthog::util::scenario_manager& scenmgr,
+	               std::string mapfile) -> int {
+		std::cerr << "mapfile=" << mapfile << std::endl;
+		if(alg == "dijkstra") { return run_dijkstra(scenmgr, mapfile, alg); }
+		else if(alg == "astar" && (!tiebreak.empty() || !queue.empty()))
+		{
+			warthog::util::tuning_profile prof;
+			prof.queue_    = queue.empty() ? "packed" : queue;
+			prof.tiebreak_ = tiebreak.empty() ? "g" : tiebreak;
+			if(prof.queue_ != "packed" && prof.queue_ != "lazy")
+			{
+				std::cerr << "err; invalid open list: " << queue << "\n";
+				return 1;
+			}
+			if(prof.tiebreak_ != "g" && prof.tiebreak_ != "h"
+			   && prof.tiebreak_ != "lifo" && prof.tiebreak_ != "fifo")
+			{
+				std::cerr << "err; invalid tie-breaking policy: " << tiebreak
+				          << "\n";
+				return 1;
+			}
+			return with_astar_config(
+			    prof, [&]<class Q, warthog::search::heuristic_evaluation HE>() {
+				    return run_astar<Q, HE>(scenmgr, mapfile, alg);
+			    });
+		}
+		else if(alg == "astar") { return run_astar(scenmgr, mapfile, alg); }
+		else if(alg == "auto")
+		{
+			return run_astar_auto(scenmgr, mapfile, alg);
+		}
+		else if(alg == "tune")
+		{
+			uint32_t num = samples.empty() ? 100 : std::stoul(samples);
+			if(map_only)
+			{
+				scenmgr.generate_experiments(&grids.get(mapfile)->map_, num);
+			}
+			if(scenmgr.num_experiments() == 0)
+			{
+				std::cerr << "err; no instances to tune on\n";
+				return 1;
+			}
+			return run_tune(scenmgr, mapfile);
+		}
+		else if(alg == "serve")
+		{
+			uint32_t num = workers.empty()
+			    ? std::max(1u, std::thread::hardware_concurrency())
+			    : std::stoul(workers);
+			if(num == 0)
+			{
+				std::cerr << "err; number of workers must be positive\n";
+				return 1;
+			}
+			return run_server(mapfile, socket, num);
+		}
+		else if(alg == "astar_lazy")
+		{
+			return run_astar<
+			    warthog::util::pqueue_min,
+			    warthog::search::heuristic_evaluation::lazy>(
+			    scenmgr, mapfile, alg);
+		}
+		else if(alg == "astar_batch")
+		{
+			uint32_t num = lanes.empty() ? 8 : std::stoul(lanes);
+			if(num == 0)
+			{
+				std::cerr << "err; number of lanes must be positive\n";
+				return 1;
+			}
+			return run_astar_batch(scenmgr, mapfile, alg, num);
+		}
+		else if(alg == "astar4c") { return run_astar4c(scenmgr, mapfile, alg); }
+		else if(alg == "gbfs") { return run_gbfs(scenmgr, mapfile, alg); }
+		else if(alg == "fringe") { return run_fringe(scenmgr, mapfile, alg); }
+		else if(alg == "fringe_vs_astar")
+		{
+			return run_fringe_vs_astar(scenmgr, mapfile);
+		}
+		else if(alg == "astar_wgm")
+		{
+			return run_wgm_astar(scenmgr, mapfile, alg, costfile);
+		}
+		else if(alg == "beam" || alg == "beam_layered")
+		{
+			uint32_t width = beamsize.empty() ? 1024 : std::stoul(beamsize);
+			if(width == 0)
+			{
+				std::cerr << "err; beam width must be positive\n";
+				return 1;
+			}
+			if(alg == "beam")
+			{
+				return run_beam<warthog::search::beam_policy::global>(
+				    scenmgr, mapfile, alg, width);
+			}
+			return run_beam<warthog::search::beam_policy::layered>(
+			    scenmgr, mapfile, alg, width);
+		}
+		else if(alg == "sma")
+		{
+			size_t nodes = budget.empty() ? 65536 : std::stoull(budget);
+			if(nodes < 2)
+			{
+				std::cerr << "err; node budget must be at least 2\n";
+				return 1;
+			}
+			return run_sma(scenmgr, mapfile, alg, nodes);
+		}
+		else if(alg == "lrta")
+		{
+			uint32_t nodes = lookahead.empty() ? 64 : std::stoul(lookahead);
+			if(nodes == 0)
+			{
+				std::cerr << "err; lookahead must be positive\n";
+				return 1;
+			}
+			return run_lrta(scenmgr, mapfile, alg, nodes);
+		}
+		std::cerr << "err; invalid search algorithm: " << alg << "\n";
+		return 1;
+	};
+
+	// with --procs the instances of every scenario file are cut into
+	// tasks, of one map each, which are solved by worker processes
+	if(nprocs)
+	{
+		std::vector<shard_task> tasks;
+		if(!add_shard_tasks(scenmgr, sfile, mapfile, size, tasks))
+		{
+			return 1;
+		}
+		for(const std::string& file : more_sfiles)
+		{
+			warthog::util::scenario_manager more;
+			more.load_scenario(file.c_str());
+			if(!add_shard_tasks(more, file, mapfile, size, tasks)) { return 1; }
+		}
+		// hosts sharing a filesystem each take every parts-th task
+		std::vector<shard_task> mine;
+		for(size_t t = part; t < tasks.size(); t += parts)
+		{
+			mine.push_back(std::move(tasks[t]));
+		}
+		return run_sharded(
+		    mine, nprocs, retries.empty() ? 3 : std::stoul(retries) + 1, run);
+	}
+
+	// instances on several maps are run one map at a time, so that each
+	// map is loaded once
+	if(mapfile == "" && scenmgr.num_maps() > 1)
+	{
+		std::vector<std::vector<uint32_t>> ids;
+		auto groups = scenmgr.split_by_map(&ids);
+		for(size_t i = 0; i < groups.size(); i++)
+		{
+			std::string file
+			    = warthog::util::find_map_filename(*groups[i], sfile);
+			if(file.empty())
+			{
+				std::cerr << "could not locate map file "
+				          << groups[i]->get_experiment(0)->map() << "\n";
+				return 1;
+			}
+			instance_ids = &ids[i];
+			if(int ret = run(*groups[i], file)) { return ret; }
+		}
+		std::cerr << "maps: " << groups.size() << ", map cache hits "
+		          << grids.get_hits() + vl_grids.get_hits() << ", misses "
+		          << grids.get_misses() + vl_grids.get_misses()
+		          << ", evictions "
+		          << grids.get_evictions() + vl_grids.get_evictions() << "\n";
+		return 0;
+	}
+
 	// the map filename can be given or (default) taken from the scenario file
 	if(mapfile == "")
 	{
@@ -321,15 +1718,5 @@ main(int argc, char** argv)
 			return 0;
 		}
 	}
-	std::cerr << "mapfile=" << mapfile << std::endl;
-
-	if(alg == "dijkstra") { return run_dijkstra(scenmgr, mapfile, alg); }
-	else if(alg == "astar") { return run_astar(scenmgr, mapfile, alg); }
-	else if(alg == "astar4c") { return run_astar4c(scenmgr, mapfile, alg); }
-	else if(alg == "astar_wgm")
-	{
-		return run_wgm_astar(scenmgr, mapfile, alg, costfile);
-	}
-	std::cerr << "err; invalid search algorithm: " << alg << "\n";
-	return 1;
+	return run(scenmgr, mapfile);
 }
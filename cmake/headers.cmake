@@ -14,13 +14,19 @@ include/warthog/forward.h
 include/warthog/limits.h
 
 include/warthog/domain/grid.h
+include/warthog/domain/grid_components.h
 include/warthog/domain/gridmap.h
 include/warthog/domain/labelled_gridmap.h
+include/warthog/domain/map_patch.h
+include/warthog/domain/map_stats.h
+include/warthog/domain/move_table.h
+include/warthog/domain/versioned_gridmap.h
 
 include/warthog/geometry/geography.h
 include/warthog/geometry/geom.h
 
 include/warthog/heuristic/heuristic_value.h
+include/warthog/heuristic/learned_heuristic.h
 include/warthog/heuristic/manhattan_heuristic.h
 include/warthog/heuristic/octile_heuristic.h
 include/warthog/heuristic/zero_heuristic.h
@@ -31,18 +37,27 @@ include/warthog/memory/arraylist.h
 include/warthog/memory/bittable.h
 include/warthog/memory/cpool.h
 include/warthog/memory/node_pool.h
+include/warthog/memory/node_store.h
 
+include/warthog/search/batch_search.h
+include/warthog/search/beam_search.h
+include/warthog/search/compact_path.h
+include/warthog/search/cost_predictor.h
 include/warthog/search/dummy_filter.h
 include/warthog/search/dummy_listener.h
 include/warthog/search/expansion_policy.h
+include/warthog/search/fringe_search.h
 include/warthog/search/gridmap_expansion_policy.h
+include/warthog/search/lss_lrta_search.h
 include/warthog/search/noop_search.h
 include/warthog/search/problem_instance.h
 include/warthog/search/search.h
 include/warthog/search/search_metrics.h
 include/warthog/search/search_node.h
 include/warthog/search/search_parameters.h
+include/warthog/search/sma_star_search.h
 include/warthog/search/solution.h
+include/warthog/search/tie_breaking.h
 include/warthog/search/uds_traits.h
 include/warthog/search/unidirectional_search.h
 include/warthog/search/vl_gridmap_expansion_policy.h
@@ -54,10 +69,20 @@ include/warthog/util/experiment.h
 include/warthog/util/file_utils.h
 include/warthog/util/gm_parser.h
 include/warthog/util/helpers.h
+include/warthog/util/lazy_pqueue.h
+include/warthog/util/locality_order.h
 include/warthog/util/log.h
+include/warthog/util/map_cache.h
 include/warthog/util/macros.h
+include/warthog/util/minmax_heap.h
+include/warthog/util/packed_pqueue.h
+include/warthog/util/prefetch.h
 include/warthog/util/pqueue.h
+include/warthog/util/query_log.h
 include/warthog/util/scenario_manager.h
+include/warthog/util/scenario_reader.h
+include/warthog/util/scenario_store.h
 include/warthog/util/timer.h
+include/warthog/util/tuning_profile.h
 include/warthog/util/vec_io.h
 )
@@ -7,6 +7,8 @@
 // @created: 01/08/2012
 //
 
+#include <warthog/defines.h>
+
 #include <bit>
 #include <cassert>
 #include <cfloat>
@@ -137,8 +139,16 @@ constexpr uint64_t INFTY
     = std::numeric_limits<uint64_t>::max(); // indicates uninitialised or
                                             // undefined values
 
-using cost_t              = double;
-constexpr cost_t COST_MAX = std::numeric_limits<cost_t>::max();
+// the type of path costs. single precision (WARTHOG_COST_FLOAT) halves
+// the size of search nodes and is accurate enough for grid maps; cost
+// comparisons should then allow for rounding (see COST_EPSILON).
+#ifdef WARTHOG_COST_FLOAT_ENABLED
+using cost_t = float;
+#else
+using cost_t = double;
+#endif
+constexpr cost_t COST_MAX     = std::numeric_limits<cost_t>::max();
+constexpr cost_t COST_EPSILON = std::numeric_limits<cost_t>::epsilon();
 constexpr cost_t COST_MIN = std::numeric_limits<cost_t>::max();
 
 // hashing constants
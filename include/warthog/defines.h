@@ -10,6 +10,14 @@
 #endif
 #endif // WARTHOG_INT128
 
+#ifdef WARTHOG_PREFETCH
+#define WARTHOG_PREFETCH_ENABLED
+#endif // WARTHOG_PREFETCH
+
+#ifdef WARTHOG_COST_FLOAT
+#define WARTHOG_COST_FLOAT_ENABLED
+#endif // WARTHOG_COST_FLOAT
+
 #endif // <warthog/config.h>
 
 #endif // WARTHOG_DEFINES_H
@@ -136,6 +136,65 @@ dir_flip(direction d) noexcept
 	return static_cast<direction>(sel >> index * 8);
 }
 
+// x/y offset of a single step in direction @param d
+// (y grows toward the south)
+constexpr int32_t
+dir_id_dx(direction_id d) noexcept
+{
+	assert(static_cast<uint8_t>(d) < 8);
+	// 2 bits per direction, biased by 1
+	constexpr uint32_t sel = (1u << (NORTH_ID << 1)) | (1u << (SOUTH_ID << 1))
+	    | (2u << (EAST_ID << 1)) | (0u << (WEST_ID << 1))
+	    | (2u << (NORTHEAST_ID << 1)) | (0u << (NORTHWEST_ID << 1))
+	    | (2u << (SOUTHEAST_ID << 1)) | (0u << (SOUTHWEST_ID << 1));
+	return static_cast<int32_t>((sel >> d * 2) & 0b11) - 1;
+}
+constexpr int32_t
+dir_id_dy(direction_id d) noexcept
+{
+	assert(static_cast<uint8_t>(d) < 8);
+	constexpr uint32_t sel = (0u << (NORTH_ID << 1)) | (2u << (SOUTH_ID << 1))
+	    | (1u << (EAST_ID << 1)) | (1u << (WEST_ID << 1))
+	    | (0u << (NORTHEAST_ID << 1)) | (0u << (NORTHWEST_ID << 1))
+	    | (2u << (SOUTHEAST_ID << 1)) | (2u << (SOUTHWEST_ID << 1));
+	return static_cast<int32_t>((sel >> d * 2) & 0b11) - 1;
+}
+
+// direction of a single step with offset (dx, dy), dx, dy in {-1, 0, 1}.
+// the zero offset has no direction; it maps to an id >= 8.
+constexpr direction_id
+dir_id_from_delta(int32_t dx, int32_t dy) noexcept
+{
+	assert(dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1);
+	// indexed by (dy+1)*3 + (dx+1); 4 bits each
+	constexpr uint64_t sel = ((uint64_t)(NORTHWEST_ID) << (0 << 2))
+	    | ((uint64_t)(NORTH_ID) << (1 << 2))
+	    | ((uint64_t)(NORTHEAST_ID) << (2 << 2))
+	    | ((uint64_t)(WEST_ID) << (3 << 2)) | ((uint64_t)(8) << (4 << 2))
+	    | ((uint64_t)(EAST_ID) << (5 << 2))
+	    | ((uint64_t)(SOUTHWEST_ID) << (6 << 2))
+	    | ((uint64_t)(SOUTH_ID) << (7 << 2))
+	    | ((uint64_t)(SOUTHEAST_ID) << (8 << 2));
+	return static_cast<direction_id>(
+	    (sel >> (((dy + 1) * 3 + (dx + 1)) * 4)) & 0b1111);
+}
+
+// the moves which are legal from a cell, as a set of direction bits.
+// @param nbhd holds the traversability of the 8 cells around it, packed
+// as by gridmap::pack_neighbours (0=NW, 1=N, 2=NE, 3=W, 4=E, 5=SW, 6=S,
+// 7=SE). no corner cutting: a diagonal move also needs both of the
+// cardinal cells it passes.
+constexpr uint8_t
+legal_moves(uint8_t nbhd) noexcept
+{
+	bool nw = nbhd & 1, n = nbhd & 2, ne = nbhd & 4, w = nbhd & 8;
+	bool e = nbhd & 16, sw = nbhd & 32, s = nbhd & 64, se = nbhd & 128;
+	return static_cast<uint8_t>(
+	    (n ? NORTH : 0) | (s ? SOUTH : 0) | (e ? EAST : 0) | (w ? WEST : 0)
+	    | (n && e && ne ? NORTHEAST : 0) | (n && w && nw ? NORTHWEST : 0)
+	    | (s && e && se ? SOUTHEAST : 0) | (s && w && sw ? SOUTHWEST : 0));
+}
+
 } // namespace warthog::grid
 
 #endif // WARTHOG_DOMAIN_GRID_H
@@ -0,0 +1,116 @@
+#ifndef WARTHOG_DOMAIN_GRID_COMPONENTS_H
+#define WARTHOG_DOMAIN_GRID_COMPONENTS_H
+
+// domain/grid_components.h
+//
+// The connected components of a gridmap. Two traversable cells are
+// connected if one can reach the other by moves between neighbouring
+// traversable cells; since diagonal moves may not cut corners, every
+// diagonal move can be replaced by two cardinal ones and the components
+// are the same for 4- and 8-connected movement.
+//
+// Components are numbered from 0 in the order of their first cell (by
+// padded id). Lookups are indexed by padded id; blocked cells belong to
+// no component. Like move_table, this is a snapshot of the map.
+//
+// After cells of the map change, ::update repairs the components. Cells
+// that become traversable are joined to their neighbours' components,
+// which are merged union-find style, in time linear in the changed
+// cells. A blocked cell can split a component, which cannot be repaired
+// locally; the components are then rebuilt.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "gridmap.h"
+#include <warthog/constants.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace warthog::domain
+{
+
+class grid_components
+{
+public:
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	grid_components(const gridmap& map);
+
+	// recompute the components of @param map
+	void
+	build(const gridmap& map);
+
+	// bring the components up to date after the cells of the rectangle
+	// at (@param x, @param y), of @param width by @param height cells,
+	// changed in @param map. returns false if they had to be rebuilt
+	// because a traversable cell became blocked.
+	bool
+	update(
+	    const gridmap& map, uint32_t x, uint32_t y, uint32_t width,
+	    uint32_t height);
+
+	// the component of @param grid_id; NONE if the cell is blocked.
+	// merged components are numbered by one of their members.
+	uint32_t
+	get(pad_id grid_id) const noexcept
+	{
+		uint32_t c = label_[grid_id.id];
+		if(c == NONE) { return NONE; }
+		while(parent_[c] != c)
+		{
+			c = parent_[c];
+		}
+		return c;
+	}
+
+	// true if @param a and @param b are traversable and connected
+	bool
+	connected(pad_id a, pad_id b) const noexcept
+	{
+		return get(a) != NONE && get(a) == get(b);
+	}
+
+	uint32_t
+	num_components() const noexcept
+	{
+		return count_;
+	}
+
+	// the number of cells in component @param c, as given by ::get
+	uint32_t
+	size(uint32_t c) const noexcept
+	{
+		return size_[c];
+	}
+
+	// the number of cells in the largest component; 0 if there are none
+	uint32_t
+	largest() const noexcept;
+
+	size_t
+	mem() const noexcept
+	{
+		return sizeof(*this) + label_.capacity() * sizeof(uint32_t)
+		    + size_.capacity() * sizeof(uint32_t)
+		    + parent_.capacity() * sizeof(uint32_t);
+	}
+
+private:
+	std::vector<uint32_t> label_;
+	std::vector<uint32_t> size_;
+	// the component each was merged into; itself if it was not
+	std::vector<uint32_t> parent_;
+	uint32_t count_ = 0;
+
+	// merge the components of @param a and @param b, the smaller into
+	// the larger so that chains of parents stay short
+	void
+	merge_(uint32_t a, uint32_t b);
+};
+
+} // namespace warthog::domain
+
+#endif // WARTHOG_DOMAIN_GRID_COMPONENTS_H
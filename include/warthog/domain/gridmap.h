@@ -25,6 +25,7 @@
 #include <warthog/util/gm_parser.h>
 #include <warthog/util/helpers.h>
 #include <warthog/util/intrin.h>
+#include <warthog/util/prefetch.h>
 
 #include <bit>
 #include <cassert>
@@ -158,6 +159,18 @@ public:
 		    = (uint8_t)(*((uint32_t*)(db_ + (pos3 - 1))) >> (bit_offset + 7));
 	}
 
+	// hint that the neighbours of @param grid_id will be read soon; touches
+	// the same three db_ rows as get_neighbours
+	void
+	prefetch_neighbours(pad_id grid_id) const noexcept
+	{
+		uint32_t dbindex
+		    = static_cast<uint32_t>(grid_id.id >> warthog::LOG2_DBWORD_BITS);
+		util::prefetch(db_ + (dbindex - dbwidth_ - 1));
+		util::prefetch(db_ + (dbindex - 1));
+		util::prefetch(db_ + (dbindex + dbwidth_ - 1));
+	}
+
 	// takes the tiles from get_neighbours and tightly packs them into 8-bits
 	// bit number in lsb order, rep 0b76543210 bit
 	// since it fits into 1 byte, result is endian agnostic
@@ -303,9 +316,21 @@ public:
 	void
 	set_label(pad_id grid_id, bool label)
 	{
+		num_traversable_ += (uint32_t)label - (uint32_t)get_label(grid_id);
 		bittable::set(grid_id, label);
 	}
 
+	// set @param count cells of row @param y, from column @param x, to
+	// the bits of @param bits, lowest first. cells are written a word at
+	// a time.
+	void
+	set_row(uint32_t x, uint32_t y, const uint64_t* bits, uint32_t count);
+
+	// copy @param count padded rows, from row @param first, of
+	// @param other, a map of the same size
+	void
+	copy_rows(const gridmap& other, uint32_t first, uint32_t count);
+
 	uint32_t
 	padded_mapsize() const noexcept
 	{
@@ -141,6 +141,17 @@ public:
 		db_[padded_id] = label;
 	}
 
+	// set @param count cells of row @param y, from column @param x (both
+	// unpadded), to @param labels
+	void
+	set_row(uint32_t x, uint32_t y, const CELL* labels, uint32_t count)
+	{
+		assert(x + count <= header_.width_ && y < header_.height_);
+		std::memcpy(
+		    db_ + to_padded_id_from_unpadded(x, y).id, labels,
+		    count * sizeof(CELL));
+	}
+
 	uint32_t
 	height() const noexcept
 	{
@@ -0,0 +1,52 @@
+#ifndef WARTHOG_DOMAIN_MAP_PATCH_H
+#define WARTHOG_DOMAIN_MAP_PATCH_H
+
+// domain/map_patch.h
+//
+// Apply the patches of a PATCH file (see io::bittable_serialize) to a map
+// in place, without reloading it. Each row of a patch is converted to
+// bits and written over the map a 64-bit word at a time.
+//
+// Structures derived from the map are brought up to date with it: a
+// move_table is recomputed around each patch, and grid_components are
+// repaired, or rebuilt if a patch closes cells (see
+// grid_components::update).
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "grid_components.h"
+#include "gridmap.h"
+#include "labelled_gridmap.h"
+#include "move_table.h"
+#include <warthog/io/grid.h>
+
+#include <cstdint>
+#include <istream>
+
+namespace warthog::domain
+{
+
+// write @param patch over @param map. returns false, leaving the map
+// unchanged, if the patch does not fit within the map or has a cell
+// that is neither traversable nor blocked.
+bool
+apply_patch(gridmap& map, const io::grid_patch& patch);
+
+// as above; the cells of the patch become the labels of the map
+bool
+apply_patch(vl_gridmap& map, const io::grid_patch& patch);
+
+// read a PATCH file from @param in and apply its patches, in order, to
+// @param map, and to @param moves and @param components if given.
+// returns the number of patches applied; throws std::runtime_error if
+// the input is not a PATCH file or a patch cannot be applied.
+uint32_t
+apply_patches(
+    std::istream& in, gridmap& map, move_table* moves = nullptr,
+    grid_components* components = nullptr);
+
+} // namespace warthog::domain
+
+#endif // WARTHOG_DOMAIN_MAP_PATCH_H
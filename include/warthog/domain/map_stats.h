@@ -0,0 +1,42 @@
+#ifndef WARTHOG_DOMAIN_MAP_STATS_H
+#define WARTHOG_DOMAIN_MAP_STATS_H
+
+// domain/map_stats.h
+//
+// Summary statistics of a gridmap, for telling maps apart when choosing
+// how to search them:
+//  - obstacle density: the fraction of cells that are blocked
+//  - components: the number of connected components, and the share of
+//    traversable cells in the largest one (see grid_components)
+//  - corridor ratio: the fraction of traversable cells with at most two
+//    traversable cardinal neighbours; high in mazes, low in open maps
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "grid_components.h"
+#include "gridmap.h"
+
+#include <cstdint>
+
+namespace warthog::domain
+{
+
+struct map_stats
+{
+	map_stats() = default;
+	map_stats(const gridmap& map, const grid_components& components);
+
+	uint32_t width_          = 0;
+	uint32_t height_         = 0;
+	uint32_t traversable_    = 0;
+	uint32_t components_     = 0;
+	double obstacle_density_ = 0;
+	double largest_share_    = 0; // of traversable cells
+	double corridor_ratio_   = 0;
+};
+
+} // namespace warthog::domain
+
+#endif // WARTHOG_DOMAIN_MAP_STATS_H
@@ -0,0 +1,70 @@
+#ifndef WARTHOG_DOMAIN_MOVE_TABLE_H
+#define WARTHOG_DOMAIN_MOVE_TABLE_H
+
+// domain/move_table.h
+//
+// The legal moves of every cell of a gridmap, one byte per cell, indexed
+// by padded id. Each byte is a set of grid::direction bits, with the no
+// corner-cutting rule already applied (see grid::legal_moves); blocked
+// cells have no moves. Looking up the moves of a cell is a single byte
+// load, instead of three row reads and some masking.
+//
+// The table is built in one pass over the map, 64 cells at a time, and
+// takes 8x the memory of the gridmap itself. It is a snapshot: changes
+// made to the map afterwards are not reflected until ::build, or
+// ::update for the changed cells, is called.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "gridmap.h"
+#include <warthog/constants.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace warthog::domain
+{
+
+class move_table
+{
+public:
+	move_table(const gridmap& map);
+
+	// recompute the moves of every cell from @param map
+	void
+	build(const gridmap& map);
+
+	// recompute the moves that can have changed after the cells of the
+	// rectangle at (@param x, @param y), of @param width by @param height
+	// cells, changed in @param map; e.g. after a patch
+	void
+	update(
+	    const gridmap& map, uint32_t x, uint32_t y, uint32_t width,
+	    uint32_t height);
+
+	// the direction bits of the legal moves from @param grid_id
+	uint8_t
+	get(pad_id grid_id) const noexcept
+	{
+		return moves_[grid_id.id];
+	}
+
+	size_t
+	mem() const noexcept
+	{
+		return sizeof(*this) + moves_.capacity();
+	}
+
+private:
+	std::vector<uint8_t> moves_;
+
+	// the moves of the 64 cells from padded id @param id
+	void
+	compute_(const gridmap& map, uint32_t id);
+};
+
+} // namespace warthog::domain
+
+#endif // WARTHOG_DOMAIN_MOVE_TABLE_H
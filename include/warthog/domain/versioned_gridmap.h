@@ -0,0 +1,210 @@
+#ifndef WARTHOG_DOMAIN_VERSIONED_GRIDMAP_H
+#define WARTHOG_DOMAIN_VERSIONED_GRIDMAP_H
+
+// domain/versioned_gridmap.h
+//
+// A gridmap whose obstacles can change while it is being searched. Each
+// batch of edits makes a new version of the map. A search reads a
+// snapshot, the version that was current when it started, and so never
+// sees the map change under it.
+//
+// Versions are published RCU-style. A reader loads the current version
+// and counts itself on it with atomic operations; there are no locks on
+// the read side. Writers are serialised: a batch of edits is applied to
+// a copy of the map that no reader holds, and the copy is published by
+// swapping the current version pointer. A version is reclaimed by the
+// first commit after it is no longer current and its last reader has
+// released it; its copy of the map is reused for a later version.
+//
+// Copies are kept up to date a block of BLOCK_ROWS rows at a time. The
+// version in which each block last changed is recorded, and a reused
+// copy is brought up to date by copying only the blocks changed since it
+// was current. Once spare copies exist, a small batch of edits costs
+// time in the number of blocks it changes rather than the size of the
+// map.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "gridmap.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace warthog::domain
+{
+
+class versioned_gridmap
+{
+	struct version;
+
+public:
+	static constexpr uint32_t BLOCK_ROWS = 16;
+
+	// set cell (x, y), in unpadded coordinates, to @param label_
+	struct edit
+	{
+		uint32_t x_;
+		uint32_t y_;
+		bool label_;
+	};
+
+	// one version of the map, held for reading. the map must not be
+	// changed; it is not const only so that it can be given to expansion
+	// policies.
+	class snapshot
+	{
+	public:
+		snapshot() : v_(nullptr) { }
+		snapshot(const snapshot&) = delete;
+		snapshot(snapshot&& other) noexcept : v_(other.v_)
+		{
+			other.v_ = nullptr;
+		}
+		~snapshot() { release(); }
+
+		snapshot&
+		operator=(const snapshot&)
+		    = delete;
+		snapshot&
+		operator=(snapshot&& other) noexcept
+		{
+			if(this != &other)
+			{
+				release();
+				v_       = other.v_;
+				other.v_ = nullptr;
+			}
+			return *this;
+		}
+
+		gridmap*
+		get() const noexcept
+		{
+			return v_ ? v_->map_.get() : nullptr;
+		}
+
+		gridmap*
+		operator->() const noexcept
+		{
+			return get();
+		}
+
+		gridmap&
+		operator*() const noexcept
+		{
+			return *get();
+		}
+
+		explicit
+		operator bool() const noexcept
+		{
+			return v_ != nullptr;
+		}
+
+		// the number of this version; the first is 0
+		uint64_t
+		get_version() const noexcept
+		{
+			return v_->number_;
+		}
+
+		// stop reading; the version may then be reclaimed
+		void
+		release() noexcept
+		{
+			if(v_) { v_->readers_.fetch_sub(1); }
+			v_ = nullptr;
+		}
+
+	private:
+		friend class versioned_gridmap;
+		explicit snapshot(version* v) : v_(v) { }
+
+		version* v_;
+	};
+
+	// version 0 is a copy of @param map
+	explicit versioned_gridmap(const gridmap& map);
+	versioned_gridmap(const versioned_gridmap&) = delete;
+	// every snapshot must have been released
+	~versioned_gridmap();
+
+	versioned_gridmap&
+	operator=(const versioned_gridmap&)
+	    = delete;
+
+	// the current version. lock-free; safe to call from any thread.
+	snapshot
+	acquire() const;
+
+	// apply @param edits, in order, as one new version and publish it.
+	// edits off the map are ignored. returns the new version number.
+	uint64_t
+	commit(const std::vector<edit>& edits);
+
+	uint64_t
+	get_version() const;
+
+	uint32_t
+	header_width() const noexcept
+	{
+		return width_;
+	}
+
+	uint32_t
+	header_height() const noexcept
+	{
+		return height_;
+	}
+
+	// copies of the map held: the current version, versions still being
+	// read and at most one spare
+	uint32_t
+	num_copies() const;
+
+	// blocks copied to bring reused copies up to date, over all commits
+	uint64_t
+	get_blocks_copied() const;
+
+	size_t
+	mem() const;
+
+private:
+	struct version
+	{
+		std::unique_ptr<gridmap> map_;
+		uint64_t number_ = 0;
+		std::atomic<uint32_t> readers_{0};
+	};
+
+	uint32_t width_;
+	uint32_t height_;
+	std::atomic<version*> current_;
+
+	// held by writers. versions are never freed before the destructor, as
+	// a reader may still be about to count itself on one; only their
+	// copies of the map are.
+	mutable std::mutex write_mutex_;
+	std::vector<std::unique_ptr<version>> versions_;
+	// the version in which each block of rows last changed
+	std::vector<uint64_t> block_changed_;
+	uint64_t blocks_copied_;
+
+	// a version no reader holds, with a copy of the map that is up to
+	// date with the current version
+	version*
+	reuse_();
+
+	// free the copies of all but one of the unused versions
+	void
+	reclaim_();
+};
+
+} // namespace warthog::domain
+
+#endif // WARTHOG_DOMAIN_VERSIONED_GRIDMAP_H
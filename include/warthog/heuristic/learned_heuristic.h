@@ -0,0 +1,137 @@
+#ifndef WARTHOG_HEURISTIC_LEARNED_HEURISTIC_H
+#define WARTHOG_HEURISTIC_LEARNED_HEURISTIC_H
+
+// heuristic/learned_heuristic.h
+//
+// A heuristic which real-time search can improve by learning. It wraps
+// a base heuristic H and keeps, for one target at a time, a table of
+// learned lowerbounds indexed by pad_id. The estimate for a state is
+// the larger of the base value and the learned value.
+//
+// The table holds one float per state. Stored values are rounded down,
+// so learned bounds stay admissible. Learning persists across queries
+// with the same target; when the target changes only the entries
+// learned so far are cleared.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "heuristic_value.h"
+#include <warthog/constants.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace warthog::heuristic
+{
+
+template<class H>
+class learned_heuristic
+{
+public:
+	// the estimate of states from which the target is unreachable
+	static constexpr cost_t DEAD_END = std::numeric_limits<float>::max();
+
+	// @param num_ids: the number of states; i.e. the largest pad_id + 1
+	learned_heuristic(H* base, size_t num_ids)
+	    : base_(base), target_(warthog::SN_ID_MAX), table_(num_ids, 0.0f)
+	{ }
+
+	~learned_heuristic() { }
+
+	cost_t
+	h(sn_id_t id, sn_id_t id2)
+	{
+		heuristic_value hv(id, id2);
+		h(&hv);
+		return hv.lb_;
+	}
+
+	void
+	h(heuristic_value* hv)
+	{
+		base_->h(hv);
+		if(hv->to_ == target_)
+		{
+			hv->lb_ = std::max<cost_t>(hv->lb_, table_[hv->from_]);
+		}
+	}
+
+	// values learned so far are valid only for the current target;
+	// switching to a different target forgets them
+	void
+	set_target(sn_id_t target)
+	{
+		if(target == target_) { return; }
+		clear();
+		target_ = target;
+	}
+
+	sn_id_t
+	get_target() const
+	{
+		return target_;
+	}
+
+	// raise the learned estimate of @param id to @param value.
+	// estimates never decrease.
+	void
+	learn(sn_id_t id, cost_t value)
+	{
+		float v = value < DEAD_END ? static_cast<float>(value)
+		                           : static_cast<float>(DEAD_END);
+		if(v > value) { v = std::nextafter(v, 0.0f); }
+		if(v <= table_[id]) { return; }
+		if(table_[id] == 0.0f) { touched_.push_back(id); }
+		table_[id] = v;
+	}
+
+	cost_t
+	get_learned(sn_id_t id) const
+	{
+		return table_[id];
+	}
+
+	// number of states with a learned estimate
+	size_t
+	num_learned() const
+	{
+		return touched_.size();
+	}
+
+	void
+	clear()
+	{
+		for(sn_id_t id : touched_)
+		{
+			table_[id] = 0.0f;
+		}
+		touched_.clear();
+	}
+
+	H*
+	get_base()
+	{
+		return base_;
+	}
+
+	size_t
+	mem()
+	{
+		return sizeof(*this) + base_->mem() + table_.capacity() * sizeof(float)
+		    + touched_.capacity() * sizeof(sn_id_t);
+	}
+
+private:
+	H* base_;
+	sn_id_t target_;
+	std::vector<float> table_;
+	std::vector<sn_id_t> touched_;
+};
+
+} // namespace warthog::heuristic
+
+#endif // WARTHOG_HEURISTIC_LEARNED_HEURISTIC_H
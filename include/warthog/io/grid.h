@@ -3,6 +3,7 @@
 
 #include <iomanip>
 #include <stdexcept>
+#include <vector>
 #include <warthog/limits.h>
 #include <warthog/memory/bittable.h>
 
@@ -25,6 +26,23 @@ enum class bittable_cell : uint8_t
 	UNKNOWN
 };
 
+// one rectangle of a PATCH file: height_ rows of width_ cells, as read,
+// to be written over the map with its top-left cell at (x_, y_)
+struct grid_patch
+{
+	uint32_t x_      = 0;
+	uint32_t y_      = 0;
+	uint32_t width_  = 0;
+	uint32_t height_ = 0;
+	std::vector<char> cells_;
+
+	const char*
+	row(uint32_t y) const noexcept
+	{
+		return cells_.data() + (size_t)y * width_;
+	}
+};
+
 class bittable_serialize
 {
 public:
@@ -96,6 +114,21 @@ public:
 	bool
 	read_header(std::istream& in);
 
+	// the number of patches given by the header of a PATCH file
+	uint32_t
+	get_patch_count() const noexcept
+	{
+		return m_patch_count;
+	}
+
+	// read the next patch of a PATCH file into @param patch. the header
+	// gives the number of patches and the height and width shared by all
+	// of them; after "map", each patch is a line "x y", the position of
+	// its top-left cell in the map, followed by its rows of cells.
+	// returns false at the end of the input or if the patch is malformed.
+	bool
+	read_patch(std::istream& in, grid_patch& patch);
+
 	template<typename BitTable>
 	bool
 	read_map(
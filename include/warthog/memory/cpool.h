@@ -82,7 +82,7 @@ public:
 	deallocate(char* addr)
 	{
 #ifndef NDEBUG
-		assert(mem_ >= addr);
+		assert(addr >= mem_);
 		if((size_t)(addr - mem_) >= pool_size_)
 		{
 			std::cerr << "err; cchunk; freeing memory outside"
@@ -98,10 +98,7 @@ public:
 	inline bool
 	contains(char* addr)
 	{
-#ifndef NDEBUG
-		assert(mem_ >= addr);
-#endif
-		if((unsigned)(addr - mem_) < pool_size_) { return true; }
+		if((size_t)(addr - mem_) < pool_size_) { return true; }
 		return false;
 	}
 
@@ -211,8 +208,7 @@ public:
 	{
 		for(unsigned int i = 0; i < num_chunks_; i++)
 		{
-			if((unsigned)(addr - chunks_[i]->first_addr())
-			   < chunks_[i]->pool_size())
+			if(chunks_[i]->contains(addr))
 			{
 				chunks_[i]->deallocate(addr);
 				return;
@@ -25,6 +25,7 @@
 
 #include "cpool.h"
 #include <warthog/search/search_node.h>
+#include <warthog/util/prefetch.h>
 
 #include <stdint.h>
 
@@ -55,6 +56,17 @@ public:
 	search::search_node*
 	get_ptr(pad_id node_id);
 
+	// hint that the node for @param node_id will be read soon.
+	// nothing is allocated; unallocated nodes are ignored.
+	inline void
+	prefetch(pad_id node_id) const noexcept
+	{
+		sn_id_t block_id = sn_id_t{node_id} >> node_pool_ns::LOG2_NBS;
+		if(block_id >= num_blocks_ || !blocks_[block_id]) { return; }
+		util::prefetch(
+		    &blocks_[block_id][sn_id_t{node_id} & node_pool_ns::NBS_MASK]);
+	}
+
 	size_t
 	mem();
 
@@ -0,0 +1,122 @@
+#ifndef WARTHOG_MEMORY_NODE_STORE_H
+#define WARTHOG_MEMORY_NODE_STORE_H
+
+// memory/node_store.h
+//
+// A store of search nodes which supports deallocation.
+//
+// Unlike memory::node_pool, which reserves room for every node in the
+// search space and never releases it, a node_store only holds the
+// nodes which are currently allocated. Node objects come from a cpool
+// and are returned to it on deallocation, so their memory is recycled
+// by subsequent allocations. Nodes are indexed by identifier, for
+// duplicate detection.
+//
+// Memory use is proportional to the largest number of nodes that were
+// allocated at the same time (see ::peak), which is what memory-bounded
+// searches need.
+//
+// Node is search::search_node, or a type derived from it.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "cpool.h"
+#include <warthog/constants.h>
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <unordered_map>
+
+namespace warthog::memory
+{
+
+template<class Node>
+class node_store
+{
+public:
+	node_store() : pool_(sizeof(Node), 1), peak_(0) { }
+
+	~node_store() { clear(); }
+
+	// a new node with identifier @param id.
+	// there must not be a node with the same id in the store.
+	Node*
+	allocate(pad_id id)
+	{
+		Node* n = new(pool_.allocate()) Node(id);
+		[[maybe_unused]] bool added = index_.emplace(sn_id_t{id}, n).second;
+		assert(added);
+		peak_ = std::max<size_t>(peak_, index_.size());
+		return n;
+	}
+
+	// release @param n; its memory is reused by later allocations
+	void
+	deallocate(Node* n)
+	{
+		[[maybe_unused]] size_t erased = index_.erase(sn_id_t{n->get_id()});
+		assert(erased == 1);
+		n->~Node();
+		pool_.deallocate(reinterpret_cast<char*>(n));
+	}
+
+	// the node with identifier @param id, or null if there is none
+	Node*
+	find(pad_id id)
+	{
+		auto it = index_.find(sn_id_t{id});
+		return it == index_.end() ? nullptr : it->second;
+	}
+
+	// release every node in the store
+	void
+	clear()
+	{
+		for(auto& [id, n] : index_)
+		{
+			n->~Node();
+		}
+		index_.clear();
+		pool_.reclaim();
+	}
+
+	// number of nodes currently allocated
+	size_t
+	size() const
+	{
+		return index_.size();
+	}
+
+	// the largest value of ::size since the last call to ::reset_peak
+	size_t
+	peak() const
+	{
+		return peak_;
+	}
+
+	void
+	reset_peak()
+	{
+		peak_ = index_.size();
+	}
+
+	size_t
+	mem()
+	{
+		return sizeof(*this) + pool_.mem()
+		    + index_.bucket_count() * sizeof(void*)
+		    + index_.size() * (sizeof(sn_id_t) + 2 * sizeof(void*));
+	}
+
+private:
+	cpool pool_;
+	std::unordered_map<sn_id_t, Node*> index_;
+	size_t peak_;
+};
+
+} // namespace warthog::memory
+
+#endif // WARTHOG_MEMORY_NODE_STORE_H
@@ -0,0 +1,221 @@
+#ifndef WARTHOG_SEARCH_BATCH_SEARCH_H
+#define WARTHOG_SEARCH_BATCH_SEARCH_H
+
+// search/batch_search.h
+//
+// Interleaved execution of many independent A* queries. A single search
+// spends much of its time waiting on cache misses: the node at the top
+// of OPEN, the map rows read to expand it and the search nodes of its
+// successors are scattered in memory, and each is needed immediately.
+//
+// This executor runs up to one query per "lane" at the same time. Each
+// lane is a small state machine holding everything a search needs: its
+// own expansion policy (and so its own node pool), its own OPEN list and
+// the problem and solution of its query. Lanes are advanced round-robin,
+// one expansion at a time. After each expansion the lane prefetches what
+// its next expansion will touch (E::prefetch on the id at the top of
+// OPEN) and control moves to the next lane, so the memory accesses of
+// one query overlap with the work of the others. When a lane finishes a
+// query it picks up the next one from the batch.
+//
+// Each lane runs a unidirectional_search one expansion at a time
+// (unidirectional_search::step), with eager heuristic evaluation, no
+// reopening and the cutoffs of search_parameters
+// (feasibility_criteria::until_cutoff). Solutions are the same as those
+// of unidirectional_search with the same parameters.
+// Times are per query, wall-clock, and so include time spent on the
+// other lanes; the throughput of the batch is what improves.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "problem_instance.h"
+#include "search_node.h"
+#include "search_parameters.h"
+#include "solution.h"
+#include "uds_traits.h"
+#include "unidirectional_search.h"
+#include <warthog/constants.h>
+#include <warthog/util/pqueue.h>
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace warthog::search
+{
+
+// H is a heuristic function, shared by all lanes
+// E is an expansion policy; one instance per lane, as each has its own
+// node pool. E must provide ::prefetch (see expansion_policy).
+// Q is the open list type; each lane owns one
+// AC is the admissibility criteria, as for unidirectional_search
+template<
+    class H, class E, class Q = util::pqueue_min,
+    admissibility_criteria AC = admissibility_criteria::any>
+class batch_search
+{
+public:
+	// one lane per expander in @param expanders
+	batch_search(H* heuristic, const std::vector<E*>& expanders)
+	    : heuristic_(heuristic), order_(nullptr), next_(0)
+	{
+		assert(!expanders.empty());
+		for(E* expander : expanders)
+		{
+			lanes_.push_back(std::make_unique<lane>(heuristic, expander));
+		}
+	}
+
+	~batch_search() { }
+
+	// solve every instance in @param pis; the solution of pis[i] is
+	// written to @param sols[i]
+	void
+	get_paths(
+	    std::vector<problem_instance>& pis, search_parameters* par,
+	    std::vector<solution>& sols)
+	{
+		get_paths(pis, par, sols, nullptr);
+	}
+
+	// as above, but instances are started in the order of @param order,
+	// a permutation of the indexes of pis (e.g. shortest predicted first)
+	void
+	get_paths(
+	    std::vector<problem_instance>& pis, search_parameters* par,
+	    std::vector<solution>& sols, const std::vector<uint32_t>* order)
+	{
+		assert(!order || order->size() == pis.size());
+		sols.resize(pis.size());
+		next_  = 0;
+		order_ = order;
+
+		uint32_t active = 0;
+		for(auto& l : lanes_)
+		{
+			if(admit_(*l, pis, par, sols)) { active++; }
+		}
+
+		while(active)
+		{
+			for(auto& lp : lanes_)
+			{
+				lane& l = *lp;
+				if(!l.sol_) { continue; }
+				if(l.search_.step(&l.spi_, par, l.sol_))
+				{
+					// warm up the next expansion before switching lanes
+					if(search_node* next = l.open_.peek())
+					{
+						l.expander_->prefetch(next->get_id());
+					}
+					continue;
+				}
+				finish_(l, par);
+				if(!admit_(l, pis, par, sols)) { active--; }
+			}
+		}
+	}
+
+	uint32_t
+	get_num_lanes() const
+	{
+		return (uint32_t)lanes_.size();
+	}
+
+	E*
+	get_expander(uint32_t lane_id = 0)
+	{
+		return lanes_.at(lane_id)->expander_;
+	}
+
+	H*
+	get_heuristic()
+	{
+		return heuristic_;
+	}
+
+	inline size_t
+	mem()
+	{
+		size_t bytes = sizeof(*this) + heuristic_->mem();
+		for(auto& l : lanes_)
+		{
+			bytes += sizeof(lane) + l->open_.mem() + l->expander_->mem();
+		}
+		return bytes;
+	}
+
+private:
+	using search_type = unidirectional_search<
+	    H, E, Q, dummy_listener, AC, feasibility_criteria::until_cutoff,
+	    reopen_policy::no>;
+
+	// the state of one in-progress query. sol_ is null when idle.
+	struct lane
+	{
+		lane(H* heuristic, E* expander)
+		    : expander_(expander), search_(heuristic, expander, &open_),
+		      pi_(nullptr), spi_(pad_id::max(), pad_id::max()), sol_(nullptr)
+		{ }
+
+		E* expander_;
+		Q open_;
+		search_type search_;
+		problem_instance* pi_;
+		search_problem_instance spi_;
+		solution* sol_;
+	};
+
+	H* heuristic_;
+	std::vector<std::unique_ptr<lane>> lanes_;
+	const std::vector<uint32_t>* order_;
+	size_t next_;
+
+	// no copy ctor
+	batch_search(const batch_search& other) { }
+	batch_search&
+	operator=(const batch_search& other)
+	{
+		return *this;
+	}
+
+	// start the next unsolved instance of the batch on @param l. queries
+	// which end before their first expansion are finished immediately.
+	// returns false if the batch has no instances left.
+	bool
+	admit_(
+	    lane& l, std::vector<problem_instance>& pis, search_parameters* par,
+	    std::vector<solution>& sols)
+	{
+		while(next_ < pis.size())
+		{
+			size_t i = order_ ? (*order_)[next_] : next_;
+			l.pi_    = &pis[i];
+			l.spi_   = l.expander_->get_problem_instance(l.pi_);
+			l.sol_   = &sols[i];
+			next_++;
+			l.sol_->reset();
+			if(l.search_.start(&l.spi_, par, l.sol_)) { return true; }
+			finish_(l, par);
+		}
+		l.sol_ = nullptr;
+		return false;
+	}
+
+	// record the final metrics and path of the query of @param l, and
+	// log the query to the recorder of @param par, if any
+	void
+	finish_(lane& l, search_parameters* par)
+	{
+		l.search_.finish(&l.spi_, l.sol_);
+		if(l.sol_->s_node_) { l.search_.extract_path(&l.spi_, l.sol_); }
+		l.search_.record(l.pi_, par, l.sol_);
+	}
+};
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_BATCH_SEARCH_H
@@ -0,0 +1,416 @@
+#ifndef WARTHOG_SEARCH_BEAM_SEARCH_H
+#define WARTHOG_SEARCH_BEAM_SEARCH_H
+
+// search/beam_search.h
+//
+// Memory-bounded best-first search. The engine works like
+// unidirectional_search, with the same heuristic (H), expansion policy
+// (E) and listener (L) parameters, but OPEN never holds more than
+// ::beam_width nodes. When a new node arrives at a full OPEN list, the
+// worst node (by f-value) is evicted; if the new node is itself the
+// worst, it is discarded instead. OPEN is therefore a double-ended
+// priority queue (util::minmax_heap, by default).
+//
+// Two policies are available:
+//  - beam_policy::global: a single best-first OPEN list, bounded to
+//    B nodes in total.
+//  - beam_policy::layered: classic breadth-first beam search. Nodes are
+//    expanded one depth layer at a time and at most B nodes (the best
+//    by f) are retained in each layer.
+//
+// Search nodes live in a memory::node_store, not in the node pool of
+// the expansion policy. A node is deleted as soon as it is evicted or
+// discarded, and an expanded node once none of its successors is left,
+// so the store holds the nodes on OPEN, their ancestors and the
+// incumbent: O(B) nodes per layer of the search tree, whatever the
+// size of the map. E enumerates successors without generating nodes
+// (see gridmap_expansion_policy::successors).
+//
+// Pruning makes the search incomplete and its solutions suboptimal;
+// the number of discarded nodes is reported in
+// search_metrics::nodes_pruned_. A deleted node is generated again if
+// it is reached again.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "dummy_listener.h"
+#include "problem_instance.h"
+#include "search_node.h"
+#include "search_parameters.h"
+#include "solution.h"
+#include "uds_traits.h"
+#include <warthog/constants.h>
+#include <warthog/heuristic/heuristic_value.h>
+#include <warthog/memory/node_store.h>
+#include <warthog/util/log.h>
+#include <warthog/util/minmax_heap.h>
+#include <warthog/util/timer.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace warthog::search
+{
+
+enum class beam_policy
+{
+	global,
+	layered
+};
+
+// a search node for beam search. a node is kept while it is referenced:
+// by each of its successors in memory and, if it is the incumbent, by
+// the solution.
+class beam_node : public search_node
+{
+public:
+	beam_node(pad_id id = pad_id::max())
+	    : search_node(id), parent_node_(nullptr), refs_(0)
+	{ }
+
+	beam_node* parent_node_;
+	uint32_t refs_;
+};
+
+// H is a heuristic function
+// E is an expansion policy which provides ::successors and ::traversable
+// Q is the open list; a double-ended priority queue
+// L is a "listener" which is used for callbacks
+// BP chooses between a global bound and a per-layer bound
+template<
+    class H, class E, class Q = util::minmax_heap_min,
+    class L = dummy_listener, beam_policy BP = beam_policy::global>
+class beam_search
+{
+public:
+	// @param queue: the OPEN list. the layered policy needs a second
+	// queue, @param next, to hold the layer under construction.
+	beam_search(
+	    H* heuristic, E* expander, Q* queue, uint32_t beam_width,
+	    Q* next = nullptr, L* listener = nullptr)
+	    : heuristic_(heuristic), expander_(expander), open_(queue),
+	      next_(next), listener_(listener), beam_width_(beam_width)
+	{
+		assert(beam_width_ > 0);
+		assert(BP == beam_policy::global || next_ != nullptr);
+	}
+
+	~beam_search() { }
+
+	void
+	get_pathcost(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+	}
+
+	void
+	get_path(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+		if(!sol->s_node_) { return; }
+
+		// every ancestor of a node in memory is also in memory
+		for(beam_node* n = static_cast<beam_node*>(sol->s_node_); n;
+		    n            = n->parent_node_)
+		{
+			sol->path_.push_back(expander_->get_state(n->get_id()));
+		}
+		assert(sol->path_.back() == expander_->get_state(spi.start_));
+		std::reverse(sol->path_.begin(), sol->path_.end());
+
+		// extract the rest of the path, from incumbent to target
+		if(sol->s_node_->get_id() != spi.target_)
+		{
+			heuristic::heuristic_value hv(
+			    sol->s_node_->get_id(), spi.target_, &sol->path_);
+			heuristic_->h(&hv);
+		}
+	}
+
+	uint32_t
+	get_beam_width() const
+	{
+		return beam_width_;
+	}
+
+	void
+	set_beam_width(uint32_t beam_width)
+	{
+		assert(beam_width > 0);
+		beam_width_ = beam_width;
+	}
+
+	// the largest number of nodes held in memory during the last search
+	size_t
+	get_peak_nodes() const
+	{
+		return store_.peak();
+	}
+
+	void
+	set_listener(L* listener)
+	{
+		listener_ = listener;
+	}
+
+	E*
+	get_expander()
+	{
+		return expander_;
+	}
+
+	H*
+	get_heuristic()
+	{
+		return heuristic_;
+	}
+
+	inline size_t
+	mem()
+	{
+		size_t bytes = open_->mem() + (next_ ? next_->mem() : 0)
+		    + store_.mem() + expander_->mem() + heuristic_->mem()
+		    + sizeof(*this);
+		return bytes;
+	}
+
+private:
+	H* heuristic_;
+	E* expander_;
+	Q* open_;
+	Q* next_;
+	L* listener_;
+	uint32_t beam_width_;
+
+	memory::node_store<beam_node> store_;
+
+	// no copy ctor
+	beam_search(const beam_search& other) { }
+	beam_search&
+	operator=(const beam_search& other)
+	{
+		return *this;
+	}
+
+	void
+	initialise_node_(
+	    beam_node* n, beam_node* parent, cost_t gval,
+	    search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		heuristic::heuristic_value hv(n->get_id(), pi->target_);
+		heuristic_->h(&hv);
+		n->init(
+		    pi->instance_id_, parent ? parent->get_id() : pad_id::max(),
+		    gval, gval + (hv.lb_ * par->get_w_admissibility()),
+		    (gval * hv.feasible_) + hv.ub_);
+		n->parent_node_ = parent;
+		if(parent) { parent->refs_++; }
+
+		bool is_target = n->get_id() == pi->target_;
+		if(is_target || hv.feasible_) { update_incumbent_(n, gval, sol); }
+	}
+
+	// make @param n, reached at cost @param gval, the incumbent solution
+	// if it improves on the current one
+	void
+	update_incumbent_(beam_node* n, cost_t gval, solution* sol)
+	{
+		if(gval >= sol->sum_of_edge_costs_) { return; }
+		n->refs_++;
+		if(beam_node* old = static_cast<beam_node*>(sol->s_node_))
+		{
+			old->refs_--;
+			release_(old);
+		}
+		sol->s_node_            = n;
+		sol->sum_of_edge_costs_ = gval;
+	}
+
+	// delete @param n if nothing refers to it, and then its ancestors
+	// which are left without successors
+	void
+	release_(beam_node* n)
+	{
+		while(n && n->refs_ == 0 && !open_->contains(n)
+		      && !(next_ && next_->contains(n)))
+		{
+			beam_node* parent = n->parent_node_;
+			store_.deallocate(n);
+			if(parent) { parent->refs_--; }
+			n = parent;
+		}
+	}
+
+	// add @param n to @param queue, keeping it within the beam.
+	// either n or the worst node already in the queue may be pruned.
+	void
+	insert_(Q* queue, beam_node* n, solution* sol)
+	{
+		if(queue->contains(n))
+		{
+			queue->decrease_key(n);
+			return;
+		}
+		if(queue->size() >= beam_width_)
+		{
+			sol->met_.nodes_pruned_++;
+			if(!(*n < *queue->peek_max()))
+			{
+				release_(n);
+				return;
+			}
+			release_(static_cast<beam_node*>(queue->pop_max()));
+		}
+		queue->push(n);
+	}
+
+	// empty @param queue, deleting its nodes
+	void
+	drop_(Q* queue)
+	{
+		while(queue->size())
+		{
+			release_(static_cast<beam_node*>(queue->pop()));
+		}
+	}
+
+	// generate the successors of @param current and insert them
+	// into @param queue
+	void
+	expand_(
+	    beam_node* current, Q* queue, search_problem_instance* pi,
+	    search_parameters* par, solution* sol)
+	{
+		pad_id ids[8];
+		cost_t costs[8];
+		uint32_t num = expander_->successors(current->get_id(), ids, costs);
+		current->set_expanded(true);
+		sol->met_.nodes_expanded_++;
+		listener_->expand_node(current);
+		trace(pi->verbose_, "Expanding:", *current);
+
+		// current is kept until all of its successors are in place
+		current->refs_++;
+		for(uint32_t i = 0; i < num; i++)
+		{
+			sol->met_.nodes_generated_++;
+			cost_t gval = current->get_g() + costs[i];
+
+			beam_node* n = store_.find(ids[i]);
+			bool is_new  = !n;
+			if(is_new) { n = store_.allocate(ids[i]); }
+			listener_->generate_node(current, n, gval, i);
+
+			if(is_new) { initialise_node_(n, current, gval, pi, par, sol); }
+			else if(gval < n->get_g() && !n->get_expanded())
+			{
+				beam_node* old = n->parent_node_;
+				n->relax(gval, current->get_id());
+				n->parent_node_ = current;
+				current->refs_++;
+				old->refs_--;
+				release_(old);
+				listener_->relax_node(n);
+				if(n->get_id() == pi->target_)
+				{
+					update_incumbent_(n, gval, sol);
+				}
+
+				// a layered search moves the node to the next layer
+				if(BP == beam_policy::layered && open_->contains(n))
+				{
+					open_->remove(n);
+				}
+			}
+			else { continue; }
+
+			if(n->get_f() < sol->sum_of_edge_costs_)
+			{
+				insert_(queue, n, sol);
+			}
+			else { release_(n); }
+		}
+		current->refs_--;
+		release_(current);
+	}
+
+	void
+	search(search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		util::timer mytimer;
+		mytimer.start();
+		open_->clear();
+		if(next_) { next_->clear(); }
+		store_.clear();
+		store_.reset_peak();
+		uint32_t heap_ops = 0;
+
+		if(pi->start_ == pad_id::max()) { return; }
+		if(!expander_->traversable(pi->start_)) { return; }
+		beam_node* start = store_.allocate(pi->start_);
+		initialise_node_(start, nullptr, 0, pi, par, sol);
+		open_->push(start);
+		listener_->generate_node(0, start, 0, UINT32_MAX);
+		user(pi->verbose_, pi);
+
+		while(true)
+		{
+			if(open_->size() == 0)
+			{
+				// the layered policy moves on to the next layer
+				if(BP == beam_policy::global || next_->size() == 0) { break; }
+				heap_ops += open_->get_heap_ops();
+				open_->clear();
+				std::swap(open_, next_);
+			}
+
+			// stop at a solution, once no open node can improve on it
+			beam_node* current = static_cast<beam_node*>(open_->peek());
+			if(current->get_f() >= sol->sum_of_edge_costs_)
+			{
+				if(BP == beam_policy::global) { break; }
+				drop_(open_);
+				continue;
+			}
+			if(!feasible<feasibility_criteria::until_cutoff>(
+			       current, &sol->met_, par))
+			{
+				break;
+			}
+
+			open_->pop();
+			sol->met_.lb_ = current->get_f();
+			expand_(
+			    current, BP == beam_policy::global ? open_ : next_, pi, par,
+			    sol);
+			sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+		}
+
+		sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+		sol->met_.nodes_surplus_
+		    = open_->size() + (next_ ? next_->size() : 0);
+		sol->met_.heap_ops_ = heap_ops + open_->get_heap_ops()
+		    + (next_ ? next_->get_heap_ops() : 0);
+
+		DO_ON_DEBUG_IF(pi->verbose_)
+		{
+			if(sol->sum_of_edge_costs_ == warthog::COST_MAX)
+			{
+				warning(pi->verbose_, "Search failed; no solution found.");
+			}
+			else { user(pi->verbose_, "Solution found", *sol->s_node_); }
+		}
+	}
+};
+
+template<class H, class E, class Q>
+beam_search(H* heuristic, E* expander, Q* queue, uint32_t beam_width)
+    -> beam_search<H, E, Q>;
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_BEAM_SEARCH_H
@@ -0,0 +1,304 @@
+#ifndef WARTHOG_SEARCH_COMPACT_PATH_H
+#define WARTHOG_SEARCH_COMPACT_PATH_H
+
+// search/compact_path.h
+//
+// A compact representation for paths on grids. Instead of storing one
+// identifier per cell (cf. solution::path_) the path is stored as a start
+// cell followed by a sequence of runs. Each run is a 16-bit word: the low
+// 3 bits hold a direction code (grid::direction_id) and the remaining
+// 13 bits hold the number of steps in that direction, minus one.
+// Runs longer than MAX_RUN steps are split.
+//
+// Straight segments, which dominate paths on open maps, cost 2 bytes
+// regardless of their length. A path with k turns needs 12 + 2k bytes
+// on the wire (see ::write).
+//
+// Identifiers are unpadded (pack_id); decoding needs the width of the
+// (unpadded) map, which is stored alongside the start cell.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/constants.h>
+#include <warthog/domain/grid.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
+#include <vector>
+
+namespace warthog::search
+{
+
+class compact_path
+{
+public:
+	static constexpr uint32_t DIR_BITS = 3;
+	static constexpr uint16_t DIR_MASK = (1u << DIR_BITS) - 1;
+	static constexpr uint32_t MAX_RUN  = 1u << (16 - DIR_BITS);
+
+	struct run
+	{
+		grid::direction_id dir_;
+		uint32_t length_;
+	};
+
+	// iterates over every cell of the path, from start to end
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = pack_id;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const pack_id*;
+		using reference         = pack_id;
+
+		const_iterator() = default;
+
+		pack_id
+		operator*() const noexcept
+		{
+			return pack_id{y_ * path_->width_ + x_};
+		}
+
+		const_iterator&
+		operator++() noexcept
+		{
+			if(run_ == path_->runs_.size())
+			{
+				// past the last cell of the path
+				run_ = UINT32_MAX;
+				return *this;
+			}
+			uint16_t word = path_->runs_[run_];
+			auto dir      = static_cast<grid::direction_id>(word & DIR_MASK);
+			x_           += grid::dir_id_dx(dir);
+			y_           += grid::dir_id_dy(dir);
+			if(++step_ == (uint32_t{word} >> DIR_BITS) + 1u)
+			{
+				step_ = 0;
+				++run_;
+			}
+			return *this;
+		}
+
+		const_iterator
+		operator++(int) noexcept
+		{
+			const_iterator tmp = *this;
+			++(*this);
+			return tmp;
+		}
+
+		bool
+		operator==(const const_iterator& other) const noexcept
+		{
+			return run_ == other.run_ && step_ == other.step_;
+		}
+
+	private:
+		friend class compact_path;
+		const compact_path* path_ = nullptr;
+		uint32_t x_               = 0;
+		uint32_t y_               = 0;
+		uint32_t run_             = UINT32_MAX;
+		uint32_t step_            = 0;
+	};
+
+	compact_path() { clear(); }
+
+	void
+	clear() noexcept
+	{
+		start_ = pack_id::max();
+		back_  = pack_id::max();
+		width_ = 0;
+		steps_ = 0;
+		runs_.clear();
+	}
+
+	// begin a new path at cell @param start of a map @param width
+	// cells wide. any previous contents are discarded.
+	void
+	reset(pack_id start, uint32_t width)
+	{
+		clear();
+		start_ = start;
+		back_  = start;
+		width_ = width;
+	}
+
+	// append one step in direction @param dir
+	inline void
+	push_back(grid::direction_id dir)
+	{
+		assert(static_cast<uint8_t>(dir) < 8);
+		steps_++;
+		advance_(dir, 1);
+		if(!runs_.empty())
+		{
+			uint16_t& last = runs_.back();
+			if((last & DIR_MASK) == dir
+			   && (uint32_t{last} >> DIR_BITS) + 1 < MAX_RUN)
+			{
+				last += (1u << DIR_BITS);
+				return;
+			}
+		}
+		runs_.push_back(static_cast<uint16_t>(dir));
+	}
+
+	// append @param length steps in direction @param dir
+	void
+	push_back(grid::direction_id dir, uint32_t length);
+
+	// append the cell @param next, which must be adjacent to the last
+	// cell of the path.
+	// @return false (and leave the path unchanged) if it is not.
+	bool
+	push_back_cell(pack_id next);
+
+	// reverse the order of the runs in the path. directions are kept.
+	// this is useful when a path is built by walking backwards from its
+	// last cell, one step at a time: append each step as it is found,
+	// then call ::reverse with the first cell, once it is known.
+	void
+	reverse(pack_id start);
+
+	// replace the contents of this path with @param path, a sequence of
+	// adjacent cells on a map @param width cells wide.
+	// @return false if two consecutive cells are not adjacent.
+	bool
+	encode(const std::vector<pack_id>& path, uint32_t width);
+
+	// append every cell of the path, start included, to @param path
+	void
+	decode(std::vector<pack_id>& path) const;
+
+	pack_id
+	start() const noexcept
+	{
+		return start_;
+	}
+
+	// the last cell of the path
+	pack_id
+	back() const noexcept
+	{
+		return back_;
+	}
+
+	uint32_t
+	width() const noexcept
+	{
+		return width_;
+	}
+
+	bool
+	empty() const noexcept
+	{
+		return start_ == pack_id::max();
+	}
+
+	// number of cells on the path, start included
+	size_t
+	size() const noexcept
+	{
+		return empty() ? 0 : steps_ + 1;
+	}
+
+	size_t
+	num_steps() const noexcept
+	{
+		return steps_;
+	}
+
+	size_t
+	num_runs() const noexcept
+	{
+		return runs_.size();
+	}
+
+	run
+	get_run(size_t index) const noexcept
+	{
+		assert(index < runs_.size());
+		uint16_t word = runs_[index];
+		return {
+		    static_cast<grid::direction_id>(word & DIR_MASK),
+		    (uint32_t{word} >> DIR_BITS) + 1u};
+	}
+
+	// the cost of the path, assuming unit cost for straight moves and
+	// sqrt(2) for diagonal moves
+	cost_t
+	cost() const noexcept;
+
+	const_iterator
+	begin() const noexcept
+	{
+		const_iterator it;
+		if(empty()) { return it; }
+		it.path_ = this;
+		it.x_    = uint32_t{start_} % width_;
+		it.y_    = uint32_t{start_} / width_;
+		it.run_  = 0;
+		return it;
+	}
+
+	const_iterator
+	end() const noexcept
+	{
+		return const_iterator();
+	}
+
+	const std::vector<uint16_t>&
+	data() const noexcept
+	{
+		return runs_;
+	}
+
+	// binary serialisation, little endian:
+	// [start: u32][width: u32][num_runs: u32][run: u16] x num_runs
+	void
+	write(std::ostream& out) const;
+	bool
+	read(std::istream& in);
+
+	size_t
+	mem() const noexcept
+	{
+		return sizeof(*this) + sizeof(uint16_t) * runs_.capacity();
+	}
+
+	bool
+	operator==(const compact_path& other) const noexcept
+	{
+		return start_ == other.start_ && width_ == other.width_
+		    && runs_ == other.runs_;
+	}
+
+private:
+	pack_id start_;
+	pack_id back_;
+	uint32_t width_;
+	uint32_t steps_;
+	std::vector<uint16_t> runs_;
+
+	void
+	advance_(grid::direction_id dir, uint32_t length) noexcept
+	{
+		int64_t delta = int64_t{grid::dir_id_dy(dir)} * width_
+		    + grid::dir_id_dx(dir);
+		back_.id += static_cast<sn_id_t>(delta * length);
+	}
+};
+
+} // namespace warthog::search
+
+std::ostream&
+operator<<(std::ostream& str, const warthog::search::compact_path& path);
+
+#endif // WARTHOG_SEARCH_COMPACT_PATH_H
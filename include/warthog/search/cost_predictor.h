@@ -0,0 +1,108 @@
+#ifndef WARTHOG_SEARCH_COST_PREDICTOR_H
+#define WARTHOG_SEARCH_COST_PREDICTOR_H
+
+// search/cost_predictor.h
+//
+// Predicts the effort of a grid query before it is run, so that a
+// scheduler can tell a cheap query from an expensive one. Predictions
+// are made from features which cost O(distance / block) to compute:
+//  - the octile distance from start to target
+//  - the obstacle density along the straight line between them, read
+//    from a coarse grid of per-block densities built with the predictor
+//  - the size of the component of the start (see grid_components)
+//
+// Queries between different components cannot be solved, and A*
+// expands the whole component of the start before it gives up; the
+// prediction for them is that size. For the others the number of
+// expansions is modelled as
+//   ln(1 + expanded) = w0 + w1 ln(1 + octile) + w2 density + w3 ln(size)
+// and the running time as a fixed cost per expansion. The weights can be
+// fitted by least squares to queries which have been run (::fit); the
+// default model is fitted to A* on a mix of random and room maps.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/domain/grid_components.h>
+#include <warthog/domain/gridmap.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace warthog::search
+{
+
+struct cost_model
+{
+	std::array<double, 4> w_    = {-2.0, 2.0, 1.0, 0.0};
+	double nanos_per_expansion_ = 450;
+};
+
+struct query_features
+{
+	double octile_;
+	double density_;
+	uint32_t component_size_;
+	bool connected_;
+};
+
+class cost_predictor
+{
+public:
+	// @param block is the side, in cells, of the blocks of the density grid
+	cost_predictor(const domain::gridmap& map, uint32_t block = 16);
+
+	// the features of the query from (@param sx, @param sy) to
+	// (@param gx, @param gy), in unpadded coordinates
+	query_features
+	features(uint32_t sx, uint32_t sy, uint32_t gx, uint32_t gy) const;
+
+	double
+	expansions(const query_features& f) const;
+
+	double
+	nanos(const query_features& f) const
+	{
+		return expansions(f) * model_.nanos_per_expansion_;
+	}
+
+	// fit the model to queries with features @param f, which expanded
+	// @param expanded nodes in @param nanos nanoseconds. the current
+	// model is kept if there are too few solvable queries to fit.
+	void
+	fit(const std::vector<query_features>& f,
+	    const std::vector<double>& expanded, const std::vector<double>& nanos);
+
+	const cost_model&
+	get_model() const noexcept
+	{
+		return model_;
+	}
+
+	void
+	set_model(const cost_model& model) noexcept
+	{
+		model_ = model;
+	}
+
+	size_t
+	mem() const noexcept
+	{
+		return sizeof(*this) + components_.mem()
+		    + density_.capacity() * sizeof(float);
+	}
+
+private:
+	const domain::gridmap* map_;
+	domain::grid_components components_;
+	cost_model model_;
+	uint32_t block_;
+	uint32_t blocks_wide_;
+	std::vector<float> density_; // blocked fraction of each block
+};
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_COST_PREDICTOR_H
@@ -49,14 +49,14 @@ public:
 	}
 
 	inline void
-	first(search_node*& ret, double& cost)
+	first(search_node*& ret, cost_t& cost)
 	{
 		current_ = 0;
 		n(ret, cost);
 	}
 
 	inline void
-	n(search_node*& ret, double& cost)
+	n(search_node*& ret, cost_t& cost)
 	{
 		if(current_ < neis_->size())
 		{
@@ -74,7 +74,7 @@ public:
 	// NB: also adjust the current neighbour index such that the
 	// subsequent call to ::next will return the nth+1 neighbour.
 	inline void
-	get_successor(uint32_t which, search_node*& ret, double& cost)
+	get_successor(uint32_t which, search_node*& ret, cost_t& cost)
 	{
 		if(which < neis_->size())
 		{
@@ -89,7 +89,7 @@ public:
 	}
 
 	inline void
-	next(search_node*& ret, double& cost)
+	next(search_node*& ret, cost_t& cost)
 	{
 		current_++;
 		n(ret, cost);
@@ -191,9 +191,17 @@ public:
 		return 0;
 	}
 
+	// hint that @param node_id is about to be expanded. the default
+	// prefetches its search node; domains may add their own data.
+	inline void
+	prefetch(pad_id node_id)
+	{
+		nodepool_->prefetch(node_id);
+	}
+
 protected:
 	inline void
-	add_neighbour(search_node* nei, double cost)
+	add_neighbour(search_node* nei, cost_t cost)
 	{
 		neis_->push_back(neighbour_record(nei, cost));
 		// std::cout << " neis_.size() == " << neis_->size() << std::endl;
@@ -209,13 +217,13 @@ protected:
 private:
 	struct neighbour_record
 	{
-		neighbour_record(search_node* node, double cost)
+		neighbour_record(search_node* node, cost_t cost)
 		{
 			node_ = node;
 			cost_ = cost;
 		}
 		search_node* node_;
-		double cost_;
+		cost_t cost_;
 	};
 
 	memory::node_pool* nodepool_;
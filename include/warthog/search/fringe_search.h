@@ -0,0 +1,283 @@
+#ifndef WARTHOG_SEARCH_FRINGE_SEARCH_H
+#define WARTHOG_SEARCH_FRINGE_SEARCH_H
+
+// search/fringe_search.h
+//
+// Fringe search (Bjornsson, Enzenberger, Holte & Schaeffer, 2005).
+// Like IDA*, the search proceeds in iterations with an increasing
+// f-threshold, but it keeps the frontier between iterations in a single
+// doubly-linked list (the "now" and "later" lists of the paper, merged)
+// and caches g-values, so no state is expanded twice in one iteration
+// and no iteration starts from scratch. There is no priority queue.
+//
+// Each iteration walks the list from the head. Nodes with f above the
+// threshold are skipped (they are "later"); others are expanded, their
+// successors inserted immediately after them and visited in the same
+// iteration, and the node itself is unlinked. The next threshold is the
+// smallest f skipped. With an admissible heuristic the first time the
+// target is visited within the threshold its cost is optimal.
+//
+// Search nodes and heuristics come from the usual expansion policy (E)
+// and heuristic (H). List links live in a side array indexed by
+// pad_id: two 32-bit indices and a copy of f per state. A node is on
+// the list iff it belongs to the current search and is not flagged as
+// expanded.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "dummy_listener.h"
+#include "problem_instance.h"
+#include "search_node.h"
+#include "search_parameters.h"
+#include "solution.h"
+#include "uds_traits.h"
+#include <warthog/constants.h>
+#include <warthog/heuristic/heuristic_value.h>
+#include <warthog/util/log.h>
+#include <warthog/util/timer.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace warthog::search
+{
+
+// H is a heuristic function
+// E is an expansion policy
+// L is a "listener" which is used for callbacks
+template<class H, class E, class L = dummy_listener>
+class fringe_search
+{
+public:
+	fringe_search(H* heuristic, E* expander, L* listener = nullptr)
+	    : heuristic_(heuristic), expander_(expander), listener_(listener),
+	      links_(expander->get_nodes_pool_size())
+	{ }
+
+	~fringe_search() { }
+
+	void
+	get_pathcost(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+	}
+
+	void
+	get_path(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+		if(!sol->s_node_) { return; }
+
+		// follow backpointers to extract the path, from start to target
+		search_node* current = sol->s_node_;
+		while(current)
+		{
+			sol->path_.push_back(expander_->get_state(current->get_id()));
+			if(current->get_parent() == pad_id::max()) break;
+			current = expander_->generate(current->get_parent());
+		}
+		assert(sol->path_.back() == expander_->get_state(spi.start_));
+		std::reverse(sol->path_.begin(), sol->path_.end());
+	}
+
+	void
+	set_listener(L* listener)
+	{
+		listener_ = listener;
+	}
+
+	E*
+	get_expander()
+	{
+		return expander_;
+	}
+
+	H*
+	get_heuristic()
+	{
+		return heuristic_;
+	}
+
+	inline size_t
+	mem()
+	{
+		return sizeof(*this) + links_.capacity() * sizeof(link)
+		    + expander_->mem() + heuristic_->mem();
+	}
+
+private:
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	// f is copied from the node so skipping a node stays within the array
+	struct link
+	{
+		uint32_t prev_;
+		uint32_t next_;
+		cost_t f_;
+	};
+
+	H* heuristic_;
+	E* expander_;
+	L* listener_;
+	std::vector<link> links_;
+	uint32_t head_;
+
+	// no copy ctor
+	fringe_search(const fringe_search& other) { }
+	fringe_search&
+	operator=(const fringe_search& other)
+	{
+		return *this;
+	}
+
+	// put @param id on the list, after @param pos (or first, if NONE)
+	inline void
+	link_after_(uint32_t pos, uint32_t id, cost_t f)
+	{
+		uint32_t next = pos == NONE ? head_ : links_[pos].next_;
+		links_[id]    = {pos, next, f};
+		if(next != NONE) { links_[next].prev_ = id; }
+		if(pos == NONE) { head_ = id; }
+		else { links_[pos].next_ = id; }
+	}
+
+	inline void
+	unlink_(uint32_t id)
+	{
+		link l = links_[id];
+		if(l.prev_ == NONE) { head_ = l.next_; }
+		else { links_[l.prev_].next_ = l.next_; }
+		if(l.next_ != NONE) { links_[l.next_].prev_ = l.prev_; }
+	}
+
+	void
+	search(search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		util::timer mytimer;
+		mytimer.start();
+		head_ = NONE;
+
+		if(pi->start_ == pad_id::max()) { return; }
+		search_node* start = expander_->generate_start_node(pi);
+		if(!start) { return; }
+
+		heuristic::heuristic_value hv(start->get_id(), pi->target_);
+		heuristic_->h(&hv);
+		start->init(
+		    pi->instance_id_, pad_id::max(), 0,
+		    hv.lb_ * par->get_w_admissibility());
+		link_after_(NONE, (uint32_t)start->get_id().id, start->get_f());
+		listener_->generate_node(0, start, 0, UINT32_MAX);
+		user(pi->verbose_, pi);
+
+		cost_t threshold = start->get_f();
+		while(head_ != NONE)
+		{
+			cost_t next_threshold = warthog::COST_MAX;
+			uint32_t id           = head_;
+			while(id != NONE)
+			{
+				if(links_[id].f_ > threshold)
+				{
+					next_threshold = std::min(next_threshold, links_[id].f_);
+					id = links_[id].next_;
+					continue;
+				}
+				search_node* current = expander_->generate(pad_id{id});
+
+				if(current->get_id() == pi->target_)
+				{
+					sol->s_node_            = current;
+					sol->sum_of_edge_costs_ = current->get_g();
+					sol->met_.lb_           = threshold;
+					break;
+				}
+				if(!feasible<feasibility_criteria::until_cutoff>(
+				       current, &sol->met_, par))
+				{
+					break;
+				}
+
+				expand_(current, pi, par, sol);
+				sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+
+				// successors follow current; visit them next
+				uint32_t next = links_[id].next_;
+				unlink_(id);
+				id = next;
+			}
+			if(id != NONE) { break; } // target found, or cutoff
+			threshold = next_threshold;
+		}
+
+		sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+		DO_ON_DEBUG_IF(pi->verbose_)
+		{
+			if(sol->sum_of_edge_costs_ == warthog::COST_MAX)
+			{
+				warning(pi->verbose_, "Search failed; no solution found.");
+			}
+			else { user(pi->verbose_, "Solution found", *sol->s_node_); }
+		}
+	}
+
+	void
+	expand_(
+	    search_node* current, search_problem_instance* pi,
+	    search_parameters* par, solution* sol)
+	{
+		expander_->expand(current, pi);
+		current->set_expanded(true);
+		sol->met_.nodes_expanded_++;
+		listener_->expand_node(current);
+		trace(pi->verbose_, "Expanding:", *current);
+
+		uint32_t pos     = (uint32_t)current->get_id().id;
+		search_node* n   = nullptr;
+		cost_t cost_to_n = warthog::COST_MAX;
+		for(uint32_t i = 0; i < expander_->get_num_successors(); i++)
+		{
+			expander_->get_successor(i, n, cost_to_n);
+			sol->met_.nodes_generated_++;
+			cost_t gval = current->get_g() + cost_to_n;
+			listener_->generate_node(current, n, gval, i);
+			uint32_t nid = (uint32_t)n->get_id().id;
+
+			if(n->get_search_number() != current->get_search_number())
+			{
+				heuristic::heuristic_value hv(n->get_id(), pi->target_);
+				heuristic_->h(&hv);
+				n->init(
+				    pi->instance_id_, current->get_id(), gval,
+				    gval + hv.lb_ * par->get_w_admissibility());
+			}
+			else if(gval < n->get_g())
+			{
+				// improved; move it (back) to the list, after current
+				n->relax(gval, current->get_id());
+				listener_->relax_node(n);
+				if(n->get_expanded())
+				{
+					n->set_expanded(false);
+					sol->met_.nodes_reopen_++;
+				}
+				else { unlink_(nid); }
+			}
+			else { continue; }
+
+			link_after_(pos, nid, n->get_f());
+			pos = nid;
+		}
+	}
+};
+
+template<class H, class E>
+fringe_search(H* heuristic, E* expander) -> fringe_search<H, E>;
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_FRINGE_SEARCH_H
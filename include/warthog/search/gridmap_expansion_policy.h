@@ -24,7 +24,9 @@
 #include "problem_instance.h"
 #include "search_node.h"
 #include <warthog/domain/gridmap.h>
+#include <warthog/domain/move_table.h>
 
+#include <cassert>
 #include <memory>
 
 namespace warthog::search
@@ -63,6 +65,30 @@ public:
 		return map_;
 	}
 
+	// search @param map from now on, e.g. a newer snapshot of a
+	// domain::versioned_gridmap. the map must be the same size as the
+	// current one, so that the node pool can be kept. a move table given
+	// to the policy describes one map and is not replaced.
+	void
+	set_map(domain::gridmap* map) noexcept
+	{
+		assert(map->width() == map_->width()
+		       && map->height() == map_->height());
+		map_ = map;
+	}
+
+	// hint that @param node_id is about to be expanded: prefetch the map
+	// rows read by the expansion, and the nodes above, at and below it
+	inline void
+	prefetch(pad_id node_id)
+	{
+		uint32_t w = map_->width();
+		map_->prefetch_neighbours(node_id);
+		expansion_policy::prefetch(pad_id{node_id.id - w});
+		expansion_policy::prefetch(node_id);
+		expansion_policy::prefetch(pad_id{node_id.id + w});
+	}
+
 	void
 	print_node(search_node* n, std::ostream& out) override;
 
@@ -76,7 +102,11 @@ protected:
 class gridmap_expansion_policy : public gridmap_expansion_policy_base
 {
 public:
-	gridmap_expansion_policy(domain::gridmap* map, bool manhattan = false);
+	// with @param moves, the legal moves of each cell are read from a
+	// precomputed table instead of the map; see domain::move_table
+	gridmap_expansion_policy(
+	    domain::gridmap* map, bool manhattan = false,
+	    const domain::move_table* moves = nullptr);
 
 	void
 	expand(search_node*, search_problem_instance*) override;
@@ -87,11 +117,31 @@ public:
 	search_node*
 	generate_target_node(search_problem_instance* pi) override;
 
+	// the successors of @param node_id and the costs of the moves to
+	// them, written to @param ids and @param costs (room for 8 each).
+	// returns their number. no search nodes are generated; for searches
+	// which keep their own, e.g. in a memory::node_store.
+	uint32_t
+	successors(pad_id node_id, pad_id* ids, cost_t* costs);
+
+	// true if @param node_id is a traversable cell of the map
+	bool
+	traversable(pad_id node_id);
+
 	size_t
 	mem() override;
 
 protected:
 	bool manhattan_;
+	// direction bits allowed by the movement model
+	uint8_t move_mask_;
+	// id offset of a move, by direction_id
+	int32_t offsets_[8];
+	const domain::move_table* moves_;
+
+	// the direction bits of the legal moves from @param node_id
+	uint32_t
+	legal_moves_(pad_id node_id);
 };
 
 } // namespace warthog::search
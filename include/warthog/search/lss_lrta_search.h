@@ -0,0 +1,376 @@
+#ifndef WARTHOG_SEARCH_LSS_LRTA_SEARCH_H
+#define WARTHOG_SEARCH_LSS_LRTA_SEARCH_H
+
+// search/lss_lrta_search.h
+//
+// Real-time, agent-centred search: LSS-LRTA* (Koenig & Sun, 2009).
+// The agent does not plan a complete path before moving. Instead each
+// step:
+//  1. runs a local A* search from the agent's position, bounded to
+//     ::lookahead expansions (unidirectional_search with an expansions
+//     cutoff);
+//  2. updates the heuristic of every state in the local closed list,
+//     with a Dijkstra-style sweep outward from the local open list;
+//  3. moves the agent to the most promising frontier state (or to the
+//     target, if the local search reached it).
+// With a lookahead of 1 the algorithm is LRTA*.
+//
+// The work done per step is bounded by the lookahead, independent of
+// the size of the map. Learned values live in a
+// heuristic::learned_heuristic and persist across queries with the same
+// target, so repeated queries converge toward optimal paths.
+//
+// The path returned in solution::path_ is the trajectory of the agent,
+// which can revisit states; solution::sum_of_edge_costs_ is its cost.
+// Total effort per query is limited by the expansions and time cutoffs
+// of search_parameters.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "problem_instance.h"
+#include "search_node.h"
+#include "search_parameters.h"
+#include "solution.h"
+#include "uds_traits.h"
+#include "unidirectional_search.h"
+#include <warthog/constants.h>
+#include <warthog/heuristic/heuristic_value.h>
+#include <warthog/heuristic/learned_heuristic.h>
+#include <warthog/util/pqueue.h>
+#include <warthog/util/timer.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace warthog::search
+{
+
+// records the nodes expanded and generated by one lookahead search
+class lss_listener
+{
+public:
+	inline void
+	generate_node(search_node*, search_node* child, cost_t, uint32_t)
+	{
+		generated_.push_back(child->get_id());
+	}
+
+	inline void
+	expand_node(search_node* current)
+	{
+		expanded_.push_back(current->get_id());
+	}
+
+	inline void
+	relax_node(search_node*)
+	{ }
+
+	void
+	clear()
+	{
+		generated_.clear();
+		expanded_.clear();
+	}
+
+	std::vector<pad_id> generated_;
+	std::vector<pad_id> expanded_;
+};
+
+// H is the base heuristic function
+// E is an expansion policy; moves must be reversible with equal costs
+// Q is the open list of the lookahead search
+template<class H, class E, class Q = util::pqueue_min>
+class lss_lrta_search
+{
+public:
+	using learned_type = heuristic::learned_heuristic<H>;
+
+	lss_lrta_search(H* heuristic, E* expander, Q* queue, uint32_t lookahead)
+	    : learned_(heuristic, expander->get_nodes_pool_size()),
+	      expander_(expander), open_(queue), lookahead_(lookahead),
+	      local_(&learned_, expander, queue, &listener_)
+	{
+		assert(lookahead_ > 0);
+	}
+
+	~lss_lrta_search() { }
+
+	void
+	get_pathcost(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		get_path(pi, par, sol);
+	}
+
+	void
+	get_path(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		util::timer mytimer;
+		mytimer.start();
+		num_steps_          = 0;
+		max_step_expanded_  = 0;
+		max_step_time_nano_ = 0;
+
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		if(spi.start_ == pad_id::max() || spi.target_ == pad_id::max())
+		{
+			return;
+		}
+		learned_.set_target(sn_id_t{spi.target_});
+
+		pad_id agent    = spi.start_;
+		cost_t traveled = 0;
+		sol->path_.push_back(expander_->get_state(agent));
+		while(agent != spi.target_)
+		{
+			sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+			if(sol->met_.nodes_expanded_ >= par->get_max_expansions_cutoff()
+			   || sol->met_.time_elapsed_nano_ > par->get_max_time_cutoff()
+			   || !step_(agent, spi, par, sol, traveled))
+			{
+				// out of time, or the target is unreachable
+				sol->path_.clear();
+				sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+				return;
+			}
+		}
+
+		sol->s_node_            = expander_->generate(spi.target_);
+		sol->sum_of_edge_costs_ = traveled;
+		sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+	}
+
+	uint32_t
+	get_lookahead() const
+	{
+		return lookahead_;
+	}
+
+	void
+	set_lookahead(uint32_t lookahead)
+	{
+		assert(lookahead > 0);
+		lookahead_ = lookahead;
+	}
+
+	// the heuristic values learned so far
+	learned_type*
+	get_learned_heuristic()
+	{
+		return &learned_;
+	}
+
+	// forget everything learned so far
+	void
+	reset_learning()
+	{
+		learned_.clear();
+	}
+
+	// statistics for the most recent query
+	uint32_t
+	get_num_steps() const
+	{
+		return num_steps_;
+	}
+
+	uint32_t
+	get_max_step_expanded() const
+	{
+		return max_step_expanded_;
+	}
+
+	uint64_t
+	get_max_step_time_nano() const
+	{
+		return max_step_time_nano_;
+	}
+
+	E*
+	get_expander()
+	{
+		return expander_;
+	}
+
+	H*
+	get_heuristic()
+	{
+		return learned_.get_base();
+	}
+
+	inline size_t
+	mem()
+	{
+		return sizeof(*this) + open_->mem() + expander_->mem()
+		    + learned_.mem()
+		    + (listener_.generated_.capacity()
+		       + listener_.expanded_.capacity())
+		    * sizeof(pad_id);
+	}
+
+private:
+	using local_search = unidirectional_search<
+	    learned_type, E, Q, lss_listener,
+	    admissibility_criteria::w_admissible,
+	    feasibility_criteria::until_cutoff>;
+
+	// a state touched by the learning sweep
+	struct sweep_entry
+	{
+		cost_t h_;
+		bool closed_;
+		bool done_;
+	};
+	using sweep_item = std::pair<cost_t, sn_id_t>;
+
+	learned_type learned_;
+	E* expander_;
+	Q* open_;
+	uint32_t lookahead_;
+	lss_listener listener_;
+	local_search local_;
+
+	std::unordered_map<sn_id_t, sweep_entry> sweep_;
+	std::priority_queue<
+	    sweep_item, std::vector<sweep_item>, std::greater<sweep_item>>
+	    sweep_queue_;
+
+	uint32_t num_steps_;
+	uint32_t max_step_expanded_;
+	uint64_t max_step_time_nano_;
+
+	// no copy ctor
+	lss_lrta_search(const lss_lrta_search& other) { }
+	lss_lrta_search&
+	operator=(const lss_lrta_search& other)
+	{
+		return *this;
+	}
+
+	// one search-learn-move iteration. moves @param agent and adds the
+	// cost of the move to @param traveled. returns false if the agent
+	// cannot move; i.e. there is no path to the target.
+	bool
+	step_(
+	    pad_id& agent, search_problem_instance& spi, search_parameters* par,
+	    solution* sol, cost_t& traveled)
+	{
+		util::timer steptimer;
+		steptimer.start();
+
+		// 1. lookahead
+		search_problem_instance local_pi(agent, spi.target_, spi.verbose_);
+		search_parameters local_par;
+		local_par.set_max_expansions_cutoff(lookahead_);
+		local_par.verbose_ = par->verbose_;
+		solution local_sol;
+		listener_.clear();
+		local_.get_path(&local_pi, &local_par, &local_sol);
+
+		sol->met_.nodes_expanded_  += local_sol.met_.nodes_expanded_;
+		sol->met_.nodes_generated_ += local_sol.met_.nodes_generated_;
+		sol->met_.nodes_reopen_    += local_sol.met_.nodes_reopen_;
+		sol->met_.heap_ops_        += local_sol.met_.heap_ops_;
+		sol->met_.nodes_surplus_    = local_sol.met_.nodes_surplus_;
+
+		// the target is never added to OPEN; move there if it is at
+		// least as good as the best open node
+		search_node* best = open_->size() ? open_->peek() : nullptr;
+		if(local_sol.s_node_
+		   && (!best || local_sol.sum_of_edge_costs_ <= best->get_f()))
+		{
+			best = local_sol.s_node_;
+		}
+		if(!best
+		   || learned_.h(sn_id_t{best->get_id()}, sn_id_t{spi.target_})
+		       >= learned_type::DEAD_END)
+		{
+			return false;
+		}
+
+		// 2. learning
+		learn_(&local_pi);
+
+		// 3. move, appending to the trajectory in order
+		size_t from = sol->path_.size();
+		for(search_node* n = best; n->get_id() != agent;
+		    n               = expander_->generate(n->get_parent()))
+		{
+			sol->path_.push_back(expander_->get_state(n->get_id()));
+		}
+		std::reverse(sol->path_.begin() + from, sol->path_.end());
+		traveled += best->get_g();
+		agent     = best->get_id();
+
+		num_steps_++;
+		max_step_expanded_ = std::max<uint32_t>(
+		    max_step_expanded_, local_sol.met_.nodes_expanded_);
+		max_step_time_nano_ = std::max<uint64_t>(
+		    max_step_time_nano_, steptimer.elapsed_time_nano().count());
+		return true;
+	}
+
+	// Dijkstra from the local frontier into the local closed list:
+	// h(s) = min over successors s' of c(s, s') + h(s').
+	// closed states which cannot reach the frontier are dead ends.
+	void
+	learn_(search_problem_instance* pi)
+	{
+		sweep_.clear();
+		for(pad_id id : listener_.expanded_)
+		{
+			sweep_[sn_id_t{id}] = {warthog::COST_MAX, true, false};
+		}
+		for(pad_id id : listener_.generated_)
+		{
+			auto [it, added] = sweep_.try_emplace(
+			    sn_id_t{id}, sweep_entry{0, false, false});
+			if(!added) { continue; }
+			it->second.h_ = learned_.h(sn_id_t{id}, sn_id_t{pi->target_});
+			sweep_queue_.push({it->second.h_, sn_id_t{id}});
+		}
+
+		while(!sweep_queue_.empty())
+		{
+			auto [h, id] = sweep_queue_.top();
+			sweep_queue_.pop();
+			sweep_entry& e = sweep_[id];
+			if(e.done_) { continue; }
+			e.done_ = true;
+			if(e.closed_) { learned_.learn(id, h); }
+
+			expander_->expand(expander_->generate(pad_id{id}), pi);
+			search_node* n = nullptr;
+			cost_t cost    = warthog::COST_MAX;
+			for(uint32_t i = 0; i < expander_->get_num_successors(); i++)
+			{
+				expander_->get_successor(i, n, cost);
+				auto it = sweep_.find(sn_id_t{n->get_id()});
+				if(it == sweep_.end() || !it->second.closed_
+				   || it->second.done_ || h + cost >= it->second.h_)
+				{
+					continue;
+				}
+				it->second.h_ = h + cost;
+				sweep_queue_.push({h + cost, sn_id_t{n->get_id()}});
+			}
+		}
+
+		for(auto& [id, e] : sweep_)
+		{
+			if(e.closed_ && !e.done_)
+			{
+				learned_.learn(id, learned_type::DEAD_END);
+			}
+		}
+	}
+};
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_LSS_LRTA_SEARCH_H
@@ -6,7 +6,10 @@
 namespace warthog::search
 {
 
-static uint32_t instance_counter_ = UINT32_MAX;
+// instance ids tell a node pool which nodes belong to the current search.
+// the counter is per thread, so searches on different threads (each with
+// its own node pool) never race for ids.
+static thread_local uint32_t instance_counter_ = UINT32_MAX;
 
 template<Identity STATE>
 class problem_instance_base
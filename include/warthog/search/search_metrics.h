@@ -28,6 +28,7 @@ struct search_metrics
 		nodes_generated_   = other.nodes_generated_;
 		nodes_surplus_     = other.nodes_surplus_;
 		nodes_reopen_      = other.nodes_reopen_;
+		nodes_pruned_      = other.nodes_pruned_;
 		heap_ops_          = other.heap_ops_;
 		lb_                = other.lb_;
 		ub_                = other.ub_;
@@ -42,6 +43,7 @@ struct search_metrics
 		nodes_generated_   = 0;
 		nodes_surplus_     = 0;
 		nodes_reopen_      = 0;
+		nodes_pruned_      = 0;
 		heap_ops_          = 0;
 		lb_                = warthog::COST_MAX;
 		ub_                = warthog::COST_MAX;
@@ -52,6 +54,7 @@ struct search_metrics
 	uint32_t nodes_generated_;
 	uint32_t nodes_surplus_;
 	uint32_t nodes_reopen_;
+	uint32_t nodes_pruned_; // discarded by memory-bounded searches
 	uint32_t heap_ops_;
 
 	// bounds established during the search
@@ -19,7 +19,8 @@ class search_node
 {
 public:
 	search_node(pad_id id = pad_id::max())
-	    : id_(id), parent_id_(warthog::SN_ID_MAX), g_(warthog::COST_MAX),
+	    : id_(to_stored(id)), parent_id_(stored_id::max()),
+	      g_(warthog::COST_MAX),
 	      f_(warthog::COST_MAX), ub_(warthog::COST_MAX), status_(0),
 	      priority_(warthog::INF32), search_number_(UINT32_MAX)
 	{
@@ -33,7 +34,7 @@ public:
 	    uint32_t search_number, pad_id parent_id, cost_t g, cost_t f,
 	    cost_t ub = warthog::COST_MAX)
 	{
-		parent_id_     = parent_id;
+		parent_id_     = to_stored(parent_id);
 		f_             = f;
 		g_             = g;
 		ub_            = ub;
@@ -56,37 +57,51 @@ public:
 	inline pad_id
 	get_id() const
 	{
-		return id_;
+		return from_stored(id_);
 	}
 
 	inline void
 	set_id(pad_id id)
 	{
-		id_ = id;
+		id_ = to_stored(id);
 	}
 
 	inline bool
 	get_expanded() const
 	{
-		return status_;
+		return status_ & EXPANDED;
 	}
 
 	inline void
 	set_expanded(bool expanded)
 	{
-		status_ = expanded;
+		status_ = (status_ & ~EXPANDED) | (expanded ? EXPANDED : 0);
+	}
+
+	// true if the node is keyed on a bound and its heuristic value has
+	// not been evaluated yet (see heuristic_evaluation::lazy)
+	inline bool
+	get_deferred() const
+	{
+		return status_ & DEFERRED;
+	}
+
+	inline void
+	set_deferred(bool deferred)
+	{
+		status_ = (status_ & ~DEFERRED) | (deferred ? DEFERRED : 0);
 	}
 
 	inline pad_id
 	get_parent() const
 	{
-		return parent_id_;
+		return from_stored(parent_id_);
 	}
 
 	inline void
 	set_parent(pad_id parent_id)
 	{
-		parent_id_ = parent_id;
+		parent_id_ = to_stored(parent_id);
 	}
 
 	inline uint32_t
@@ -144,7 +159,7 @@ public:
 		f_ = (f_ - g_) + g;
 		g_ = g;
 		if(ub_ < warthog::COST_MAX) { ub_ = (ub_ - g_) + g; }
-		parent_id_ = parent_id;
+		parent_id_ = to_stored(parent_id);
 	}
 
 	inline bool
@@ -207,7 +222,7 @@ public:
 	{
 		out << "search_node id:" << get_id().id;
 		out << " p_id: ";
-		out << parent_id_.id;
+		out << get_parent().id;
 		out << " g: " << g_ << " f: " << this->get_f() << " ub: " << ub_
 		    << " expanded: " << get_expanded() << " "
 		    << " search_number_: " << search_number_;
@@ -226,15 +241,38 @@ public:
 	}
 
 private:
-	pad_id id_;
-	pad_id parent_id_;
+	static constexpr uint8_t EXPANDED = 1;
+	static constexpr uint8_t DEFERRED = 2;
+
+	// with single-precision costs ids are 32-bit too, and a node takes
+	// 32 bytes rather than 56. pad_id::none() is preserved.
+#ifdef WARTHOG_COST_FLOAT_ENABLED
+	using stored_id = pad32_id;
+#else
+	using stored_id = pad_id;
+#endif
+
+	static constexpr stored_id
+	to_stored(pad_id id)
+	{
+		return id.is_none() ? stored_id::none() : stored_id(id);
+	}
+
+	static constexpr pad_id
+	from_stored(stored_id id)
+	{
+		return id.is_none() ? pad_id::none() : pad_id(id);
+	}
+
+	stored_id id_;
+	stored_id parent_id_;
 
 	cost_t g_;
 	cost_t f_;
 	cost_t ub_;
 
 	// TODO steal the high-bit from priority instead of ::status_ ?
-	uint8_t status_;    // open or closed
+	uint8_t status_;    // EXPANDED and DEFERRED flags
 	uint32_t priority_; // expansion priority
 
 	uint32_t search_number_;
@@ -268,6 +306,21 @@ struct cmp_less_search_node_f_only
 	}
 };
 
+// orders nodes by h-value (f - g) alone, as greedy best-first search
+// requires; ties are broken as cmp_less_search_node
+struct cmp_less_search_node_h_only
+{
+	inline bool
+	operator()(const search_node& first, const search_node& second)
+	{
+		cost_t h1 = first.get_f() - first.get_g();
+		cost_t h2 = second.get_f() - second.get_g();
+		if(h1 < h2) { return true; }
+		if(h2 < h1) { return false; }
+		return first < second;
+	}
+};
+
 } // namespace warthog::search
 
 std::ostream&
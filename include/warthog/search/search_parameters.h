@@ -14,6 +14,13 @@
 
 #include <warthog/constants.h>
 
+#include <chrono>
+
+namespace warthog::util
+{
+class query_recorder;
+} // namespace warthog::util
+
 namespace warthog::search
 {
 
@@ -63,7 +70,7 @@ public:
 	}
 
 	uint32_t
-	get_max_expansions_cutoff()
+	get_max_expansions_cutoff() const
 	{
 		return exp_cutoff_;
 	}
@@ -91,7 +98,7 @@ public:
 	}
 
 	double
-	get_w_admissibility()
+	get_w_admissibility() const
 	{
 		return w_admissibility_;
 	}
@@ -112,6 +119,20 @@ public:
 		return eps_admissibility_;
 	}
 
+	// record each query solved with these parameters to @param recorder;
+	// null to stop recording
+	void
+	set_recorder(util::query_recorder* recorder)
+	{
+		recorder_ = recorder;
+	}
+
+	util::query_recorder*
+	get_recorder() const
+	{
+		return recorder_;
+	}
+
 	bool verbose_;
 
 private:
@@ -119,7 +140,8 @@ private:
 	uint32_t exp_cutoff_;
 	std::chrono::nanoseconds time_cutoff_ns_;
 	double w_admissibility_;
-	cost_t eps_admissibility_ = 0;
+	cost_t eps_admissibility_        = 0;
+	util::query_recorder* recorder_ = nullptr;
 };
 
 } // namespace warthog::search
@@ -0,0 +1,449 @@
+#ifndef WARTHOG_SEARCH_SMA_STAR_SEARCH_H
+#define WARTHOG_SEARCH_SMA_STAR_SEARCH_H
+
+// search/sma_star_search.h
+//
+// Simplified Memory-bounded A* (Russell, 1992). The search never holds
+// more than ::max_nodes search nodes in memory. When the budget is
+// exhausted, the worst leaf on OPEN (highest f, shallowest on ties) is
+// deleted and its f-value is backed up to its parent. The parent
+// remembers the lowest f-value among its forgotten successors and goes
+// back on OPEN, keyed by that value, so the forgotten subtree is
+// regenerated once it becomes the most promising part of the search.
+//
+// This implementation generates all successors of a node at once
+// (as in SMAG*) and detects duplicates: a node reached by a better path
+// is re-parented and, if it has been expanded, reopened. Every node
+// carries a lower bound on the cost of the paths it represents, which
+// is at least that of its parent (pathmax). A backup only ever raises
+// the bound of a node and the key of a node on OPEN is never below its
+// bound, so the keys expanded never decrease. A successor that is
+// skipped as a duplicate is represented by the copy in memory, which
+// has a path no more expensive.
+//
+// Provided the heuristic is admissible and the budget is large enough
+// to hold an optimal path (plus one node set of successors), the
+// returned solution is optimal. Otherwise the search can fail even if
+// a solution exists; it gives up once the expansions at one f-value
+// show that it is only deleting and regenerating the same nodes. Nodes
+// deleted to make room are counted in search_metrics::nodes_pruned_.
+//
+// The search nodes live in a memory::node_store, which deallocates and
+// recycles their memory. E enumerates successors without generating
+// nodes (see gridmap_expansion_policy::successors), so memory use does
+// not grow with the part of the map that is explored.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "dummy_listener.h"
+#include "problem_instance.h"
+#include "search_node.h"
+#include "search_parameters.h"
+#include "solution.h"
+#include "uds_traits.h"
+#include <warthog/constants.h>
+#include <warthog/heuristic/heuristic_value.h>
+#include <warthog/memory/node_store.h>
+#include <warthog/util/log.h>
+#include <warthog/util/minmax_heap.h>
+#include <warthog/util/timer.h>
+
+#include <algorithm>
+
+namespace warthog::search
+{
+
+// a search node for SMA*. ::fval_ bounds the cost of the paths which
+// the node represents: the paths through its successors in memory and
+// through those it forgot. it is raised by backups and lowered only when
+// the node is reached by a better path. the key of a node on OPEN is
+// ::fval_ if the node has not been expanded, else the lowest f-value
+// among its forgotten successors, which is never lower than ::fval_.
+class sma_node : public search_node
+{
+public:
+	sma_node(pad_id id = pad_id::max())
+	    : search_node(id), parent_node_(nullptr), fval_(warthog::COST_MAX),
+	      forgotten_f_(warthog::COST_MAX), children_(0),
+	      leaf_index_(warthog::INF32)
+	{ }
+
+	sma_node* parent_node_;
+	cost_t fval_;         // lower bound on paths via the node
+	cost_t forgotten_f_;  // lowest f among deleted successors
+	uint32_t children_;   // number of successors in memory
+	uint32_t leaf_index_; // position in the heap of deletable leaves
+};
+
+// leaves are kept in a second heap, indexed by sma_node::leaf_index_
+struct heap_index_sma_leaf
+{
+	static inline uint32_t
+	get(const search_node* n)
+	{
+		return static_cast<const sma_node*>(n)->leaf_index_;
+	}
+
+	static inline void
+	set(search_node* n, uint32_t index)
+	{
+		static_cast<sma_node*>(n)->leaf_index_ = index;
+	}
+};
+
+// H is a heuristic function
+// E is an expansion policy which provides ::successors and ::traversable
+// L is a "listener" which is used for callbacks
+template<class H, class E, class L = dummy_listener>
+class sma_star_search
+{
+public:
+	sma_star_search(
+	    H* heuristic, E* expander, size_t max_nodes, L* listener = nullptr)
+	    : heuristic_(heuristic), expander_(expander), listener_(listener),
+	      max_nodes_(max_nodes)
+	{
+		assert(max_nodes_ > 1);
+	}
+
+	~sma_star_search() { }
+
+	void
+	get_pathcost(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+	}
+
+	void
+	get_path(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+		if(!sol->s_node_) { return; }
+
+		// every ancestor of a node in memory is also in memory
+		for(sma_node* n = static_cast<sma_node*>(sol->s_node_); n;
+		    n          = n->parent_node_)
+		{
+			sol->path_.push_back(expander_->get_state(n->get_id()));
+		}
+		assert(sol->path_.back() == expander_->get_state(spi.start_));
+		std::reverse(sol->path_.begin(), sol->path_.end());
+	}
+
+	size_t
+	get_max_nodes() const
+	{
+		return max_nodes_;
+	}
+
+	void
+	set_max_nodes(size_t max_nodes)
+	{
+		assert(max_nodes > 1);
+		max_nodes_ = max_nodes;
+	}
+
+	// the largest number of nodes held in memory during the last search
+	size_t
+	get_peak_nodes() const
+	{
+		return store_.peak();
+	}
+
+	void
+	set_listener(L* listener)
+	{
+		listener_ = listener;
+	}
+
+	E*
+	get_expander()
+	{
+		return expander_;
+	}
+
+	H*
+	get_heuristic()
+	{
+		return heuristic_;
+	}
+
+	inline size_t
+	mem()
+	{
+		return open_.mem() + leaves_.mem() + store_.mem() + expander_->mem()
+		    + heuristic_->mem() + sizeof(*this);
+	}
+
+private:
+	H* heuristic_;
+	E* expander_;
+	L* listener_;
+	size_t max_nodes_;
+
+	memory::node_store<sma_node> store_;
+
+	// expansions at one key, per node in the budget, after which the
+	// search gives up. enumerating the paths which tie at one key can
+	// take several hundred expansions per node.
+	static constexpr uint64_t STALL_FACTOR = 1000;
+
+	// OPEN holds the nodes which have successors to (re)generate.
+	// the leaves of the search tree, other than the root and the node
+	// being expanded, are also held in a second heap; its worst element
+	// is the next one to be deleted.
+	util::minmax_heap_min open_;
+	util::minmax_heap<cmp_less_search_node, heap_index_sma_leaf> leaves_;
+
+	// no copy ctor
+	sma_star_search(const sma_star_search& other) { }
+	sma_star_search&
+	operator=(const sma_star_search& other)
+	{
+		return *this;
+	}
+
+	cost_t
+	h_(pad_id id, search_problem_instance* pi, search_parameters* par)
+	{
+		heuristic::heuristic_value hv(id, pi->target_);
+		heuristic_->h(&hv);
+		return hv.lb_ * par->get_w_admissibility();
+	}
+
+	// (re)insert @param n into OPEN with key @param f
+	void
+	requeue_(sma_node* n, cost_t f)
+	{
+		n->set_f(f);
+		if(open_.contains(n)) { open_.decrease_key(n); }
+		else { open_.push(n); }
+		if(leaves_.contains(n)) { leaves_.decrease_key(n); }
+	}
+
+	// put @param n, which is not being expanded, on OPEN if it has
+	// successors to regenerate, and with the leaves if it has none in
+	// memory. a leaf with nothing to regenerate is a dead end; its key of
+	// COST_MAX makes it the first to be deleted. a node waiting to be
+	// expanded (again) keeps its key.
+	void
+	update_(sma_node* n)
+	{
+		if(!n->get_expanded()) { assert(open_.contains(n)); }
+		else if(n->forgotten_f_ != warthog::COST_MAX)
+		{
+			requeue_(n, std::max(n->fval_, n->forgotten_f_));
+		}
+		else if(n->children_ == 0) { requeue_(n, warthog::COST_MAX); }
+		else if(open_.contains(n)) { open_.remove(n); }
+		if(n->children_ == 0 && n->parent_node_ && !leaves_.contains(n))
+		{
+			leaves_.push(n);
+		}
+	}
+
+	// delete the worst leaf and back up its key to its parent.
+	// @param current is the node being expanded; it is updated by the
+	// caller when it is done.
+	void
+	evict_(sma_node* current, solution* sol)
+	{
+		sma_node* victim = static_cast<sma_node*>(leaves_.pop_max());
+		assert(victim->children_ == 0 && open_.contains(victim));
+		open_.remove(victim);
+
+		sma_node* parent     = victim->parent_node_;
+		parent->forgotten_f_ = std::min(parent->forgotten_f_, victim->get_f());
+		parent->children_--;
+		store_.deallocate(victim);
+		sol->met_.nodes_pruned_++;
+		if(parent != current) { update_(parent); }
+	}
+
+	// @param n, already in memory, is reached via @param parent by a
+	// path of lower cost @param gval, with bound @param fval. the node
+	// starts over from the new path; if it has successors they are
+	// regenerated, to propagate the new g-value. a path of the same cost
+	// is skipped: the bound of n holds for it too, whatever its parent.
+	void
+	relax_(
+	    sma_node* n, sma_node* parent, cost_t gval, cost_t fval,
+	    solution* sol)
+	{
+		sma_node* old = n->parent_node_;
+		if(old != parent)
+		{
+			old->children_--;
+			parent->children_++;
+			n->parent_node_ = parent;
+			if(old->children_ == 0) { update_(old); }
+		}
+		n->relax(gval, parent->get_id());
+		n->fval_        = fval;
+		n->forgotten_f_ = warthog::COST_MAX;
+		listener_->relax_node(n);
+
+		if(n->get_expanded())
+		{
+			n->set_expanded(false);
+			sol->met_.nodes_reopen_++;
+		}
+		requeue_(n, fval);
+	}
+
+	void
+	expand_(
+	    sma_node* current, search_problem_instance* pi,
+	    search_parameters* par, solution* sol)
+	{
+		// current is expanded with its key, which bounds all of its
+		// successors that are not in memory, and so bounds them again
+		// once they are regenerated (pathmax)
+		current->fval_        = std::max(current->fval_, current->get_f());
+		current->forgotten_f_ = warthog::COST_MAX;
+
+		pad_id ids[8];
+		cost_t costs[8];
+		uint32_t num = expander_->successors(current->get_id(), ids, costs);
+		current->set_expanded(true);
+		sol->met_.nodes_expanded_++;
+		listener_->expand_node(current);
+		trace(pi->verbose_, "Expanding:", *current);
+
+		for(uint32_t i = 0; i < num; i++)
+		{
+			sol->met_.nodes_generated_++;
+			pad_id id   = ids[i];
+			cost_t gval = current->get_g() + costs[i];
+			cost_t fval = std::max(gval + h_(id, pi, par), current->fval_);
+
+			sma_node* n = store_.find(id);
+			if(n)
+			{
+				if(gval < n->get_g())
+				{
+					relax_(n, current, gval, fval, sol);
+				}
+				continue;
+			}
+
+			// when memory is full the successor takes the place of the
+			// worst leaf, unless it is worse still; it is then forgotten
+			// as soon as it is generated. if there is no leaf to delete,
+			// the path through current is too long to fit into memory.
+			if(store_.size() >= max_nodes_)
+			{
+				search_node* worst = leaves_.peek_max();
+				if(!worst) { continue; }
+				if(worst->get_f() < fval)
+				{
+					current->forgotten_f_
+					    = std::min(current->forgotten_f_, fval);
+					sol->met_.nodes_pruned_++;
+					continue;
+				}
+				evict_(current, sol);
+			}
+
+			n = store_.allocate(id);
+			n->init(pi->instance_id_, current->get_id(), gval, fval);
+			n->fval_        = fval;
+			n->parent_node_ = current;
+			current->children_++;
+			open_.push(n);
+			leaves_.push(n);
+			listener_->generate_node(current, n, gval, i);
+			trace(pi->verbose_, "Generate:", *n);
+		}
+		update_(current);
+	}
+
+	void
+	search(search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		util::timer mytimer;
+		mytimer.start();
+		open_.clear();
+		leaves_.clear();
+		store_.clear();
+		store_.reset_peak();
+
+		if(pi->start_ == pad_id::max()) { return; }
+		if(!expander_->traversable(pi->start_)) { return; }
+
+		sma_node* start = store_.allocate(pi->start_);
+		start->fval_    = h_(pi->start_, pi, par);
+		start->init(pi->instance_id_, pad_id::max(), 0, start->fval_);
+		open_.push(start);
+		listener_->generate_node(0, start, 0, UINT32_MAX);
+		user(pi->verbose_, pi);
+
+		// every key is at least that of the node being expanded, so the
+		// keys expanded never decrease. when the budget cannot hold the
+		// paths at one key, the search deletes and regenerates the same
+		// nodes forever; we give up after STALL_FACTOR expansions per node
+		// in the budget without the key increasing.
+		const uint64_t stall_limit = STALL_FACTOR * max_nodes_;
+		uint64_t iteration = 0;
+		while(true)
+		{
+			sma_node* current = static_cast<sma_node*>(open_.peek());
+
+			// a key of COST_MAX means every remaining path is too long
+			// to fit into memory
+			if(!current || current->get_f() == warthog::COST_MAX) { break; }
+			if(!feasible<feasibility_criteria::until_cutoff>(
+			       current, &sol->met_, par))
+			{
+				break;
+			}
+
+			if(current->get_id() == pi->target_)
+			{
+				sol->s_node_            = current;
+				sol->sum_of_edge_costs_ = current->get_g();
+				sol->met_.ub_           = current->get_g();
+				break;
+			}
+
+			assert(current->get_f() >= sol->met_.lb_
+			       || sol->met_.lb_ == warthog::COST_MAX);
+			if(current->get_f() != sol->met_.lb_)
+			{
+				sol->met_.lb_ = current->get_f();
+				iteration     = 0;
+			}
+			else if(++iteration > stall_limit)
+			{
+				warning(pi->verbose_, "Search stalled at f =", sol->met_.lb_);
+				break;
+			}
+
+			open_.pop();
+			if(leaves_.contains(current)) { leaves_.remove(current); }
+			expand_(current, pi, par, sol);
+			sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+		}
+
+		sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+		sol->met_.nodes_surplus_     = open_.size();
+		sol->met_.heap_ops_ = open_.get_heap_ops() + leaves_.get_heap_ops();
+
+		DO_ON_DEBUG_IF(pi->verbose_)
+		{
+			if(sol->sum_of_edge_costs_ == warthog::COST_MAX)
+			{
+				warning(pi->verbose_, "Search failed; no solution found.");
+			}
+			else { user(pi->verbose_, "Solution found", *sol->s_node_); }
+		}
+	}
+};
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_SMA_STAR_SEARCH_H
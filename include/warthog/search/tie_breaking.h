@@ -0,0 +1,79 @@
+#ifndef WARTHOG_SEARCH_TIE_BREAKING_H
+#define WARTHOG_SEARCH_TIE_BREAKING_H
+
+// search/tie_breaking.h
+//
+// Tie-breaking policies for best-first search. Nodes are ordered by f;
+// the policy decides which of several nodes with equal f comes first:
+//  - larger_g: deepest node first (the order of search_node::operator<)
+//  - smaller_h: node closest to the target first, by heuristic value
+//  - lifo: most recently queued node first
+//  - fifo: least recently queued node first
+//
+// The ordering is precomputed as a single 64-bit key (see packed_key),
+// so that one integer comparison orders two nodes. The upper
+// FKEY_BITS hold f in fixed point, with a resolution of 1/F_SCALE; the
+// lower TIE_BITS hold the tie-breaker. Values too large for their
+// field saturate; insertion counters wrap every 2^TIE_BITS nodes.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include "search_node.h"
+#include <warthog/constants.h>
+
+#include <cstdint>
+
+namespace warthog::search
+{
+
+enum class tie_breaking
+{
+	larger_g,
+	smaller_h,
+	lifo,
+	fifo
+};
+
+constexpr uint32_t TIE_BITS  = 24;
+constexpr uint32_t FKEY_BITS = 64 - TIE_BITS;
+constexpr double F_SCALE     = 4096; // f resolution is 1/4096
+constexpr double TIE_SCALE   = 16;   // g and h resolution is 1/16
+constexpr uint64_t TIE_MASK  = (1ULL << TIE_BITS) - 1;
+constexpr uint64_t FKEY_MAX  = (1ULL << FKEY_BITS) - 1;
+
+// @param value in fixed point with @param scale, saturating at @param max
+constexpr uint64_t
+fixed_point(cost_t value, double scale, uint64_t max)
+{
+	cost_t v = value * scale;
+	return v >= static_cast<cost_t>(max) ? max : static_cast<uint64_t>(v);
+}
+
+// @param seq is the number of nodes queued before @param n; it is used
+// by the insertion-order policies only.
+template<tie_breaking TB>
+constexpr uint64_t
+packed_key(const search_node& n, uint64_t seq)
+{
+	uint64_t tie = 0;
+	if constexpr(TB == tie_breaking::larger_g)
+	{
+		tie = TIE_MASK - fixed_point(n.get_g(), TIE_SCALE, TIE_MASK);
+	}
+	else if constexpr(TB == tie_breaking::smaller_h)
+	{
+		tie = fixed_point(n.get_f() - n.get_g(), TIE_SCALE, TIE_MASK);
+	}
+	else if constexpr(TB == tie_breaking::lifo)
+	{
+		tie = TIE_MASK - (seq & TIE_MASK);
+	}
+	else { tie = seq & TIE_MASK; }
+	return (fixed_point(n.get_f(), F_SCALE, FKEY_MAX) << TIE_BITS) | tie;
+}
+
+} // namespace warthog::search
+
+#endif // WARTHOG_SEARCH_TIE_BREAKING_H
@@ -7,6 +7,7 @@
 //   - to determine admissibility
 //   - to determine termination
 //   - to determine whether to reopen
+//   - to determine when heuristic values are computed
 //
 // @author: dharabor
 // @created: 2021-10-12
@@ -147,6 +148,38 @@ reopen<reopen_policy::yes>()
 	return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+enum class heuristic_evaluation
+{
+	eager,
+	lazy
+};
+
+// decide whether to defer heuristic evaluation. eager evaluation computes
+// h for every node as it is generated. lazy evaluation queues new nodes
+// on a bound derived from their parent and computes h only when the node
+// reaches the front of OPEN. we handle the lazy case via specialisation.
+template<heuristic_evaluation HE>
+inline bool
+lazy_evaluation()
+{
+	return false;
+}
+
+template<>
+inline bool
+lazy_evaluation<heuristic_evaluation::lazy>()
+{
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// open lists which do not support decrease_key (e.g. util::lazy_pqueue)
+// declare a static member `lazy_deletion`. the search pushes a node
+// again whenever it improves and the queue discards outdated entries.
+template<class Q>
+concept lazy_deletion_queue = Q::lazy_deletion;
+
 } // namespace warthog::search
 
 #endif // WARTHOG_SEARCH_UDS_TRAITS_H
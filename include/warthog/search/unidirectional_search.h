@@ -10,6 +10,7 @@
 // @created: 2021-10-13
 //
 
+#include "compact_path.h"
 #include "dummy_listener.h"
 #include "problem_instance.h"
 #include "search.h"
@@ -21,9 +22,12 @@
 #include <warthog/memory/cpool.h>
 #include <warthog/util/log.h>
 #include <warthog/util/pqueue.h>
+#include <warthog/util/prefetch.h>
+#include <warthog/util/query_log.h>
 #include <warthog/util/timer.h>
 #include <warthog/util/vec_io.h>
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -40,11 +44,16 @@ namespace warthog::search
 // required for a solution to be returned, and feasibility criteria
 // used determine if a search should continue or terminate.
 // (default: search for any solution, until OPEN is exhausted)
+// HE chooses when heuristic values are computed. lazy evaluation keys
+// new nodes on a lowerbound derived from the parent (exact when h is
+// consistent) and pays for h only when a node reaches the top of OPEN;
+// it is reinserted if its key grows. worthwhile for expensive heuristics.
 template<
     class H, class E, class Q = util::pqueue_min, class L = dummy_listener,
     admissibility_criteria AC = admissibility_criteria::any,
     feasibility_criteria FC   = feasibility_criteria::until_exhaustion,
-    reopen_policy RP          = reopen_policy::no>
+    reopen_policy RP          = reopen_policy::no,
+    heuristic_evaluation HE   = heuristic_evaluation::eager>
 class unidirectional_search
 {
 public:
@@ -59,7 +68,9 @@ public:
 	void
 	get_pathcost(problem_instance* pi, search_parameters* par, solution* sol)
 	{
-		search(pi, par, sol);
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+		record(pi, par, sol);
 	}
 
 	void
@@ -67,6 +78,7 @@ public:
 	{
 		search_problem_instance spi = expander_->get_problem_instance(pi);
 		get_path(&spi, par, sol);
+		record(pi, par, sol);
 	}
 	void
 	get_path(
@@ -77,7 +89,14 @@ public:
 		// heuristic knows a concrete path to the target.
 		search(spi, par, sol);
 		if(!sol->s_node_) { return; }
+		extract_path(spi, sol);
+	}
 
+	// the path of @param sol, from the start of @param spi to its
+	// incumbent and then on to the target, written to ::path_
+	void
+	extract_path(search_problem_instance* spi, solution* sol)
+	{
 		// follow backpointers to extract the path, from start to incumbent
 		search_node* current = sol->s_node_;
 		while(current)
@@ -113,6 +132,248 @@ public:
 		}
 	}
 
+	// as ::get_path, but the path is emitted directly in compact form,
+	// one step at a time while following backpointers; ::path_ of
+	// @param sol is left empty. requires a grid expansion policy.
+	void
+	get_path(
+	    problem_instance* pi, search_parameters* par, solution* sol,
+	    compact_path* path)
+	{
+		search_problem_instance spi = expander_->get_problem_instance(pi);
+		search(&spi, par, sol);
+		record(pi, par, sol);
+		path->clear();
+		if(!sol->s_node_) { return; }
+
+		// steps are found in reverse order, from incumbent to start;
+		// compact_path::reverse puts them right once the start is known
+		search_node* current = sol->s_node_;
+		path->reset(
+		    expander_->get_state(current->get_id()),
+		    expander_->get_map()->header_width());
+		int32_t x, y, px, py;
+		expander_->get_xy(current->get_id(), x, y);
+		while(current->get_parent() != pad_id::max())
+		{
+			current = expander_->generate(current->get_parent());
+			expander_->get_xy(current->get_id(), px, py);
+			path->push_back(grid::dir_id_from_delta(x - px, y - py));
+			x = px;
+			y = py;
+		}
+		assert(current->get_id() == spi.start_);
+		path->reverse(expander_->get_state(current->get_id()));
+
+		// extract the rest of the path, from incumbent to target
+		if(sol->s_node_->get_id() != spi.target_)
+		{
+			std::vector<pack_id> suffix;
+			heuristic::heuristic_value hv(
+			    sol->s_node_->get_id(), spi.target_, &suffix);
+			heuristic_->h(&hv);
+			for(pack_id cell : suffix)
+			{
+				if(cell == path->back()) { continue; }
+				[[maybe_unused]] bool adjacent = path->push_back_cell(cell);
+				assert(adjacent);
+			}
+		}
+	}
+
+	// the search, one expansion at a time, for executors which interleave
+	// several searches (see batch_search). ::search is ::start, then
+	// ::step until it returns false, then ::finish.
+
+	// clear OPEN and push the start node of @param pi. returns false if
+	// there is nothing to search.
+	bool
+	start(search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		timer_.start();
+		open_->clear();
+
+		// initialise the start node and push to OPEN
+		if(pi->start_ == pad_id::max()) { return false; }
+
+		search_node* start = expander_->generate_start_node(pi);
+		if(!start) { return false; }
+		// search_node* target = expander_->generate_target_node(pi);
+		// pi.target_ = target.id_;
+
+		initialise_node_(start, pad_id::max(), 0, pi, par, sol);
+		open_->push(start);
+		listener_->generate_node(0, start, 0, UINT32_MAX);
+		user(pi->verbose_, pi);
+		trace(pi->verbose_, "Start node:", *start);
+		update_ub(start, sol, pi);
+		return true;
+	}
+
+	// expand the most promising node on OPEN. returns false once it is
+	// no longer feasible to do so; e.g., we exceeded a cutoff or proved
+	// that no solution exists, or the incumbent is admissible.
+	bool
+	step(search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		if(!feasible<FC>(open_->peek(), &sol->met_, par)) { return false; }
+
+		// check if the incumbent solution is admissible
+		if(admissible<AC>(
+		       open_->peek()->get_f(), sol->sum_of_edge_costs_, par))
+		{
+			return false;
+		}
+
+		// incumbent is not not admissible. expand the most
+		// promising node from the OPEN list:
+		search_node* current = open_->pop();
+		if(lazy_evaluation<HE>() && current->get_deferred())
+		{
+			// the key was a lowerbound; requeue if the real f is larger
+			cost_t key = current->get_f();
+			evaluate_node_(current, pi, par, sol);
+			if(current->get_f() > key)
+			{
+				if(current->get_f() < sol->sum_of_edge_costs_)
+				{
+					open_->push(current);
+					trace(pi->verbose_, "Evaluated;", *current);
+				}
+				return true;
+			}
+		}
+		expander_->expand(current, pi);
+		current->set_expanded(true); // NB: set before generating succ
+		sol->met_.nodes_expanded_++;
+		sol->met_.lb_ = current->get_f();
+		listener_->expand_node(current);
+		trace(pi->verbose_, "Expanding:", *current);
+
+		// Generate successors of the current node
+		search_node* n   = nullptr;
+		cost_t cost_to_n = warthog::COST_MAX;
+		for(uint32_t i = 0; i < expander_->get_num_successors(); i++)
+		{
+			expander_->get_successor(i, n, cost_to_n);
+			sol->met_.nodes_generated_++;
+			cost_t gval = current->get_g() + cost_to_n;
+			listener_->generate_node(current, n, gval, i);
+
+			// Generate new search nodes, provided they're not
+			// dominated by the current upperbound
+			if(n->get_search_number() != current->get_search_number())
+			{
+				if(lazy_evaluation<HE>() && n->get_id() != pi->target_)
+				{
+					defer_node_(n, current, gval, cost_to_n, pi, par);
+				}
+				else
+				{
+					initialise_node_(
+					    n, current->get_id(), gval, pi, par, sol);
+				}
+				if(n->get_f() < sol->sum_of_edge_costs_)
+				{
+					open_->push(n);
+					trace(pi->verbose_, "Generate:", *n);
+					update_ub(current, sol, pi);
+					continue;
+				}
+			}
+
+			// relax and reopen, but only if the new lowerbound
+			// for the node is less than the current upperbound. a closed
+			// node which is not reopened keeps its path: its successors
+			// were generated with its g-value.
+			if(gval < n->get_g() && (reopen<RP>() || !n->get_expanded()))
+			{
+				if((gval + n->get_f() - n->get_g()) < sol->sum_of_edge_costs_)
+				{
+					n->relax(gval, current->get_id());
+					listener_->relax_node(n);
+
+					// a cheaper path to the target improves the incumbent
+					if(n->get_id() == pi->target_
+					   && gval < sol->sum_of_edge_costs_)
+					{
+						sol->s_node_            = n;
+						sol->sum_of_edge_costs_ = gval;
+					}
+
+					if constexpr(lazy_deletion_queue<Q>)
+					{
+						// queue a new entry; the old one is now stale
+						if(!n->get_expanded())
+						{
+							open_->push(n);
+							trace(pi->verbose_, "Updating;", *n);
+							update_ub(current, sol, pi);
+							continue;
+						}
+					}
+					else if(open_->contains(n))
+					{
+						open_->decrease_key(n);
+						trace(pi->verbose_, "Updating;", *n);
+						update_ub(current, sol, pi);
+						continue;
+					}
+
+					if(reopen<RP>())
+					{
+						open_->push(n);
+						trace(pi->verbose_, "Reopen;", *n);
+						update_ub(current, sol, pi);
+						sol->met_.nodes_reopen_++;
+						continue;
+					}
+				}
+			}
+			trace(pi->verbose_, "Dominated;", *n);
+		}
+		if constexpr(util::PREFETCH_HINTS)
+		{
+			// map rows and nodes read by the next expansion
+			if(search_node* next = open_->peek())
+			{
+				expander_->prefetch(next->get_id());
+			}
+		}
+		sol->met_.time_elapsed_nano_ = timer_.elapsed_time_nano();
+		return true;
+	}
+
+	// record the final metrics of the search of @param pi
+	void
+	finish(search_problem_instance* pi, solution* sol)
+	{
+		sol->met_.time_elapsed_nano_ = timer_.elapsed_time_nano();
+		sol->met_.nodes_surplus_     = open_->size();
+		sol->met_.heap_ops_          = open_->get_heap_ops();
+
+		DO_ON_DEBUG_IF(pi->verbose_)
+		{
+			if(sol->sum_of_edge_costs_ == warthog::COST_MAX)
+			{
+				warning(pi->verbose_, "Search failed; no solution exists.");
+			}
+			else { user(pi->verbose_, "Solution found", *sol->s_node_); }
+		}
+	}
+
+	// log the query @param pi to the recorder of @param par, if any.
+	// the get_path* functions do so; executors which use ::finish call
+	// it themselves.
+	void
+	record(problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		if(par->get_recorder())
+		{
+			par->get_recorder()->record(*pi, *par, *sol);
+		}
+	}
+
 	void
 	set_listener(L* listener)
 	{
@@ -152,6 +413,7 @@ private:
 	E* expander_;
 	Q* open_;
 	L* listener_;
+	util::timer timer_;
 
 	// no copy ctor
 	unidirectional_search(const unidirectional_search& other) { }
@@ -169,9 +431,42 @@ private:
 	initialise_node_(
 	    search_node* n, pad_id parent_id, cost_t gval,
 	    search_problem_instance* pi, search_parameters* par, solution* sol)
+	{
+		n->init(pi->instance_id_, parent_id, gval, gval);
+		evaluate_node_(n, pi, par, sol);
+	}
+
+	/**
+	 * As ::initialise_node_, but without evaluating the heuristic. The
+	 * node is keyed on a lowerbound derived from its parent (@param
+	 * current) and marked as deferred. Used by lazy evaluation.
+	 */
+	void
+	defer_node_(
+	    search_node* n, search_node* current, cost_t gval, cost_t edge_cost,
+	    search_problem_instance* pi, search_parameters* par)
+	{
+		// with consistent h, f(n) >= f(current) - (w - 1) * c(current, n)
+		cost_t key = std::max<cost_t>(
+		    gval,
+		    current->get_f()
+		        - (par->get_w_admissibility() - 1) * edge_cost);
+		n->init(pi->instance_id_, current->get_id(), gval, key);
+		n->set_deferred(true);
+	}
+
+	/**
+	 * Compute the heuristic value of @param n and set its f-value and
+	 * upperbound accordingly.
+	 */
+	void
+	evaluate_node_(
+	    search_node* n, search_problem_instance* pi, search_parameters* par,
+	    solution* sol)
 	{
 		heuristic::heuristic_value hv(n->get_id(), pi->target_);
 		heuristic_->h(&hv);
+		cost_t gval = n->get_g();
 
 		// NB: unlikely, but node cost  overflow could occur
 		assert((warthog::COST_MAX - hv.lb_) > gval);
@@ -179,10 +474,9 @@ private:
 		    hv.ub_ == warthog::COST_MAX
 		    || ((warthog::COST_MAX - hv.ub_) > gval));
 
-		n->init(
-		    pi->instance_id_, parent_id, gval,
-		    gval + (hv.lb_ * par->get_w_admissibility()),
-		    (gval * hv.feasible_) + hv.ub_);
+		n->set_f(gval + (hv.lb_ * par->get_w_admissibility()));
+		n->set_ub((gval * hv.feasible_) + hv.ub_);
+		n->set_deferred(false);
 
 		// update the incumbent solution
 		bool is_target = n->get_id() == pi->target_;
@@ -208,117 +502,9 @@ private:
 	void
 	search(search_problem_instance* pi, search_parameters* par, solution* sol)
 	{
-		util::timer mytimer;
-		mytimer.start();
-		open_->clear();
-
-		// initialise the start node and push to OPEN
-		{
-			if(pi->start_ == pad_id::max()) { return; }
-
-			search_node* start = expander_->generate_start_node(pi);
-			if(!start) { return; }
-			// search_node* target = expander_->generate_target_node(pi);
-			// pi.target_ = target.id_;
-
-			initialise_node_(start, pad_id::max(), 0, pi, par, sol);
-			open_->push(start);
-			listener_->generate_node(0, start, 0, UINT32_MAX);
-			user(pi->verbose_, pi);
-			trace(pi->verbose_, "Start node:", *start);
-			update_ub(start, sol, pi);
-		}
-
-		// keep expanding until it is no longer feasible to do so;
-		// e.g., we exceeded a cutoff or prove that no solution exists
-		while(feasible<FC>(open_->peek(), &sol->met_, par))
-		{
-			// check if the incumbent solution is admissible
-			if(admissible<AC>(
-			       open_->peek()->get_f(), sol->sum_of_edge_costs_, par))
-			{
-				break;
-			}
-
-			// incumbent is not not admissible. expand the most
-			// promising node from the OPEN list:
-			search_node* current = open_->pop();
-			expander_->expand(current, pi);
-			current->set_expanded(true); // NB: set before generating succ
-			sol->met_.nodes_expanded_++;
-			sol->met_.lb_ = current->get_f();
-			listener_->expand_node(current);
-			trace(pi->verbose_, "Expanding:", *current);
-
-			// Generate successors of the current node
-			search_node* n   = nullptr;
-			cost_t cost_to_n = warthog::COST_MAX;
-			for(uint32_t i = 0; i < expander_->get_num_successors(); i++)
-			{
-				expander_->get_successor(i, n, cost_to_n);
-				sol->met_.nodes_generated_++;
-				cost_t gval = current->get_g() + cost_to_n;
-				listener_->generate_node(current, n, gval, i);
-
-				// Generate new search nodes, provided they're not
-				// dominated by the current upperbound
-				if(n->get_search_number() != current->get_search_number())
-				{
-					initialise_node_(n, current->get_id(), gval, pi, par, sol);
-					if(n->get_f() < sol->sum_of_edge_costs_)
-					{
-						open_->push(n);
-						trace(pi->verbose_, "Generate:", *n);
-						update_ub(current, sol, pi);
-						continue;
-					}
-				}
-
-				// relax and reopen, but only if the new lowerbound
-				// for the node is less than the current upperbound
-				if(gval < n->get_g())
-				{
-					if((gval + n->get_f() - n->get_g())
-					   < sol->sum_of_edge_costs_)
-					{
-						n->relax(gval, current->get_id());
-						listener_->relax_node(n);
-
-						if(open_->contains(n))
-						{
-							open_->decrease_key(n);
-							trace(pi->verbose_, "Updating;", *n);
-							update_ub(current, sol, pi);
-							continue;
-						}
-
-						if(reopen<RP>())
-						{
-							open_->push(n);
-							trace(pi->verbose_, "Reopen;", *n);
-							update_ub(current, sol, pi);
-							sol->met_.nodes_reopen_++;
-							continue;
-						}
-					}
-				}
-				trace(pi->verbose_, "Dominated;", *n);
-			}
-			sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
-		}
-
-		sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
-		sol->met_.nodes_surplus_     = open_->size();
-		sol->met_.heap_ops_          = open_->get_heap_ops();
-
-		DO_ON_DEBUG_IF(pi->verbose_)
-		{
-			if(sol->sum_of_edge_costs_ == warthog::COST_MAX)
-			{
-				warning(pi->verbose_, "Search failed; no solution exists.");
-			}
-			else { user(pi->verbose_, "Solution found", *sol->s_node_); }
-		}
+		if(!start(pi, par, sol)) { return; }
+		while(step(pi, par, sol)) { }
+		finish(pi, sol);
 	}
 };
 
@@ -328,6 +514,13 @@ unidirectional_search(
     H* heuristic, E* expander, Q* queue,
     L* listener = nullptr) -> unidirectional_search<H, E, Q, L>;
 
+// greedy best-first search: OPEN is ordered by h alone and the search
+// stops as soon as the target is generated (admissibility_criteria::any
+// accepts the first incumbent), rather than when it is expanded.
+template<class H, class E, class L = dummy_listener>
+using greedy_best_first_search
+    = unidirectional_search<H, E, util::pqueue_min_h, L>;
+
 } // namespace warthog::search
 
 #endif // WARTHOG_SEARCH_UNIDIRECTIONAL_SEARCH_H
@@ -0,0 +1,198 @@
+#ifndef WARTHOG_UTIL_LAZY_PQUEUE_H
+#define WARTHOG_UTIL_LAZY_PQUEUE_H
+
+// util/lazy_pqueue.h
+//
+// A min priority queue of search nodes without decrease_key. When a
+// queued node improves it is simply pushed again; the entries made
+// before the improvement become stale and are discarded when they
+// reach the top. An entry is stale if the g-value recorded with it is
+// no longer the g-value of its node.
+//
+// Entries are plain {key, g, node} records ordered by a packed 64-bit
+// key (see search/tie_breaking.h). Nodes do not need to know where
+// they are in the heap, so search_node::priority_ is not used, and
+// every heap operation moves 24-byte records within one flat array.
+//
+// The queue may hold more entries than there are live nodes; ::size
+// counts both. There is no ::contains or ::decrease_key;
+// unidirectional_search recognises the queue via ::lazy_deletion and
+// pushes improved nodes instead.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/search/search_node.h>
+#include <warthog/search/tie_breaking.h>
+#include <warthog/util/prefetch.h>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace warthog::util
+{
+
+template<search::tie_breaking TB = search::tie_breaking::larger_g>
+class lazy_pqueue
+{
+public:
+	static constexpr bool lazy_deletion = true;
+
+	lazy_pqueue(unsigned int size = 1024) : seq_(0), heap_ops_(0)
+	{
+		elts_.reserve(size);
+	}
+
+	~lazy_pqueue() { }
+
+	void
+	clear()
+	{
+		elts_.clear();
+		seq_      = 0;
+		heap_ops_ = 0;
+	}
+
+	// add an entry for @param val. earlier entries for the same node
+	// are stale if its g-value has changed since.
+	void
+	push(search::search_node* val)
+	{
+		heap_ops_++;
+		elts_.push_back(
+		    {search::packed_key<TB>(*val, seq_++), val->get_g(), val});
+		sift_up(elts_.size() - 1);
+	}
+
+	search::search_node*
+	pop()
+	{
+		if(!skip_stale()) { return nullptr; }
+		heap_ops_++;
+		search::search_node* ans = elts_.front().node_;
+		remove_top();
+		return ans;
+	}
+
+	// the top live node. stale entries at the top are removed first.
+	inline search::search_node*
+	peek()
+	{
+		return skip_stale() ? elts_.front().node_ : nullptr;
+	}
+
+	uint32_t
+	get_heap_ops()
+	{
+		return heap_ops_;
+	}
+
+	// number of entries, including stale ones
+	inline uint32_t
+	size()
+	{
+		return (uint32_t)elts_.size();
+	}
+
+	inline bool
+	is_minqueue()
+	{
+		return true;
+	}
+
+	void
+	print(std::ostream& out)
+	{
+		for(auto& e : elts_)
+		{
+			out << "key " << e.key_ << (is_stale(e) ? " stale " : " ");
+			e.node_->print(out);
+			out << std::endl;
+		}
+	}
+
+	size_t
+	mem()
+	{
+		return elts_.capacity() * sizeof(entry) + sizeof(*this);
+	}
+
+private:
+	struct entry
+	{
+		uint64_t key_;
+		cost_t g_;
+		search::search_node* node_;
+	};
+
+	std::vector<entry> elts_;
+	uint64_t seq_;
+	uint32_t heap_ops_;
+
+	void
+	sift_up(size_t index)
+	{
+		entry e = elts_[index];
+		while(index > 0)
+		{
+			size_t parent = (index - 1) >> 1;
+			if(!(e.key_ < elts_[parent].key_)) { break; }
+			elts_[index] = elts_[parent];
+			index        = parent;
+		}
+		elts_[index] = e;
+	}
+
+	// replace the top entry with the last one and sift it down
+	void
+	remove_top()
+	{
+		entry e = elts_.back();
+		elts_.pop_back();
+		size_t size = elts_.size();
+		if(size == 0) { return; }
+
+		size_t index = 0;
+		while(true)
+		{
+			size_t child = (index << 1) + 1;
+			if(child >= size) { break; }
+			if(((index << 2) + 3) < size)
+			{
+				prefetch_hint(&elts_[(index << 2) + 3]);
+			}
+			if(child + 1 < size && elts_[child + 1].key_ < elts_[child].key_)
+			{
+				child++;
+			}
+			if(!(elts_[child].key_ < e.key_)) { break; }
+			elts_[index] = elts_[child];
+			index        = child;
+		}
+		elts_[index] = e;
+	}
+
+	static bool
+	is_stale(const entry& e)
+	{
+		return e.g_ != e.node_->get_g();
+	}
+
+	// discard stale entries from the top; false if none remain
+	bool
+	skip_stale()
+	{
+		while(!elts_.empty() && is_stale(elts_.front()))
+		{
+			heap_ops_++;
+			remove_top();
+		}
+		return !elts_.empty();
+	}
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_LAZY_PQUEUE_H
@@ -0,0 +1,47 @@
+#ifndef WARTHOG_UTIL_LOCALITY_ORDER_H
+#define WARTHOG_UTIL_LOCALITY_ORDER_H
+
+// util/locality_order.h
+//
+// Order queries so that consecutive searches cover nearby parts of the
+// map, and the map rows and search nodes one search brings into cache
+// are still there for the next.
+//
+// A query is keyed by the positions of its start and target along a
+// Hilbert curve, which keeps nearby cells close together. The bits of
+// the two positions are interleaved, so queries with nearby starts and
+// nearby targets have nearby keys. Queries are sorted by key within
+// windows of consecutive queries; a small window bounds how far a query
+// can be delayed.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <cstdint>
+#include <vector>
+
+namespace warthog::util
+{
+
+// the position of cell (@param x, @param y) along a Hilbert curve over
+// the 2^16 x 2^16 cells from (0, 0)
+uint32_t
+hilbert_index(uint32_t x, uint32_t y) noexcept;
+
+// the key of the query from (@param sx, @param sy) to (@param gx,
+// @param gy)
+uint64_t
+locality_key(uint32_t sx, uint32_t sy, uint32_t gx, uint32_t gy) noexcept;
+
+// sort each run of @param window consecutive entries of @param order by
+// @param keys of the entry, keeping the order of equal keys. a window
+// of 0 sorts the whole of @param order.
+void
+locality_order(
+    std::vector<uint32_t>& order, const std::vector<uint64_t>& keys,
+    uint32_t window);
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_LOCALITY_ORDER_H
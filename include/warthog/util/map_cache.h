@@ -0,0 +1,246 @@
+#ifndef WARTHOG_UTIL_MAP_CACHE_H
+#define WARTHOG_UTIL_MAP_CACHE_H
+
+// util/map_cache.h
+//
+// A registry of maps loaded from file, shared between threads. A map is
+// loaded the first time it is asked for and then stays resident; callers
+// hold it by std::shared_ptr for as long as they use it.
+//
+// Resident maps are kept within a memory budget. When the maps exceed
+// it, the least recently used ones that nobody holds are dropped. A map
+// in use is never dropped, so the budget can be exceeded while many maps
+// are in use at once; it is restored when the next map is loaded after
+// they are released.
+//
+// M is the map type (e.g. gridmap or vl_gridmap, or a type bundling a map
+// with indexes built over it). It must provide ::mem. By default a map
+// is loaded by the constructor M(const char* filename); any exception
+// it throws is passed on to the callers waiting for that map, and the map
+// is not cached.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace warthog::util
+{
+
+template<class M>
+class map_cache
+{
+public:
+	using loader = std::function<std::unique_ptr<M>(const std::string&)>;
+
+	// keep at most @param budget bytes of maps that are not in use.
+	// maps are read by @param load.
+	map_cache(size_t budget, loader load = default_load)
+	    : budget_(budget), load_(std::move(load)), hits_(0), misses_(0),
+	      evictions_(0)
+	{ }
+
+	map_cache(const map_cache&) = delete;
+	map_cache&
+	operator=(const map_cache&)
+	    = delete;
+
+	// the map in @param filename, loaded if not resident. concurrent
+	// callers asking for the same map wait for a single load.
+	std::shared_ptr<M>
+	get(const std::string& filename)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto it = index_.find(filename);
+		if(it != index_.end())
+		{
+			hits_++;
+			lru_.splice(lru_.begin(), lru_, it->second);
+			std::shared_future<std::shared_ptr<M>> map = it->second->map_;
+			lock.unlock();
+			return map.get();
+		}
+
+		misses_++;
+		std::promise<std::shared_ptr<M>> loading;
+		lru_.push_front({filename, loading.get_future().share()});
+		index_[filename] = lru_.begin();
+		lock.unlock();
+
+		std::shared_ptr<M> map;
+		try
+		{
+			map = load_(filename);
+		}
+		catch(...)
+		{
+			lock.lock();
+			erase_(filename);
+			lock.unlock();
+			loading.set_exception(std::current_exception());
+			throw;
+		}
+		loading.set_value(map);
+
+		lock.lock();
+		trim_();
+		return map;
+	}
+
+	// true if the map in @param filename is resident
+	bool
+	contains(const std::string& filename) const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return index_.find(filename) != index_.end();
+	}
+
+	// drop every map that is not in use
+	void
+	clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		size_t budget = budget_;
+		budget_       = 0;
+		trim_();
+		budget_ = budget;
+	}
+
+	// number of resident maps, including those still loading
+	size_t
+	size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return lru_.size();
+	}
+
+	// memory of the resident maps, in bytes
+	size_t
+	mem() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		size_t bytes = sizeof(*this);
+		for(const entry& e : lru_)
+		{
+			bytes += sizeof(entry) + e.mem();
+		}
+		return bytes;
+	}
+
+	size_t
+	get_budget() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return budget_;
+	}
+
+	void
+	set_budget(size_t budget)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		budget_ = budget;
+		trim_();
+	}
+
+	uint64_t
+	get_hits() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return hits_;
+	}
+
+	uint64_t
+	get_misses() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return misses_;
+	}
+
+	uint64_t
+	get_evictions() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return evictions_;
+	}
+
+	static std::unique_ptr<M>
+	default_load(const std::string& filename)
+	{
+		return std::make_unique<M>(filename.c_str());
+	}
+
+private:
+	struct entry
+	{
+		std::string file_;
+		std::shared_future<std::shared_ptr<M>> map_;
+
+		bool
+		ready() const
+		{
+			return map_.wait_for(std::chrono::seconds(0))
+			    == std::future_status::ready;
+		}
+
+		// 0 while loading. indexes built on demand are counted once built.
+		size_t
+		mem() const
+		{
+			return ready() ? map_.get()->mem() : 0;
+		}
+	};
+
+	size_t budget_;
+	loader load_;
+	mutable std::mutex mutex_;
+	std::list<entry> lru_; // most recently used first
+	std::unordered_map<std::string, typename std::list<entry>::iterator>
+	    index_;
+	uint64_t hits_;
+	uint64_t misses_;
+	uint64_t evictions_;
+
+	void
+	erase_(const std::string& filename)
+	{
+		auto it = index_.find(filename);
+		if(it == index_.end()) { return; }
+		lru_.erase(it->second);
+		index_.erase(it);
+	}
+
+	// drop unused maps, least recently used first, until the resident
+	// maps fit the budget. callers hold mutex_.
+	void
+	trim_()
+	{
+		size_t bytes = 0;
+		for(entry& e : lru_)
+		{
+			bytes += e.mem();
+		}
+		for(auto it = lru_.end(); bytes > budget_ && it != lru_.begin();)
+		{
+			--it;
+			// the cache holds the only reference to an unused map
+			if(!it->ready() || it->map_.get().use_count() > 1) { continue; }
+			bytes -= it->mem();
+			index_.erase(it->file_);
+			it = lru_.erase(it);
+			evictions_++;
+		}
+	}
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_MAP_CACHE_H
@@ -0,0 +1,345 @@
+#ifndef WARTHOG_UTIL_MINMAX_HEAP_H
+#define WARTHOG_UTIL_MINMAX_HEAP_H
+
+// minmax_heap.h
+//
+// A double-ended priority queue of search nodes, implemented as a
+// min-max heap (Atkinson et al., 1986). Levels of the heap alternate
+// between min levels (even depth) and max levels (odd depth).
+// Both the best and the worst element can be retrieved in constant
+// time and removed in logarithmic time.
+//
+// The interface mirrors util::pqueue, so the heap can be used as the
+// open list of a search; ::peek_max and ::pop_max additionally give
+// access to the worst element, which is what bounded-memory searches
+// need to evict.
+//
+// Like util::pqueue, the position of each node in the heap is stored
+// in search_node::priority_, by default. Searches which keep a node in
+// two heaps at once can store the second position elsewhere, via the
+// Index parameter (see heap_index_priority).
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/search/search_node.h>
+
+#include <bit>
+#include <cassert>
+#include <iostream>
+
+namespace warthog::util
+{
+
+// where a node records its position in the heap
+struct heap_index_priority
+{
+	static inline uint32_t
+	get(const search::search_node* n)
+	{
+		return n->get_priority();
+	}
+
+	static inline void
+	set(search::search_node* n, uint32_t index)
+	{
+		n->set_priority(index);
+	}
+};
+
+template<
+    class Comparator = search::cmp_less_search_node,
+    class Index      = heap_index_priority>
+class minmax_heap
+{
+public:
+	minmax_heap(unsigned int size = 1024)
+	    : maxsize_(0), queuesize_(0), elts_(nullptr), heap_ops_(0)
+	{
+		resize(size);
+	}
+
+	~minmax_heap() { delete[] elts_; }
+
+	// removes all elements from the heap
+	void
+	clear()
+	{
+		queuesize_ = 0;
+		heap_ops_  = 0;
+	}
+
+	// reprioritise the specified element, which became better
+	void
+	decrease_key(search::search_node* val)
+	{
+		assert(contains(val));
+		update(Index::get(val));
+	}
+
+	// reprioritise the specified element, which became worse
+	void
+	increase_key(search::search_node* val)
+	{
+		assert(contains(val));
+		update(Index::get(val));
+	}
+
+	// add a new element to the heap
+	void
+	push(search::search_node* val)
+	{
+		if(contains(val)) { return; }
+
+		if(queuesize_ + 1 > maxsize_) { resize(maxsize_ * 2); }
+		unsigned int index = queuesize_;
+		elts_[index]       = val;
+		Index::set(val, index);
+		queuesize_++;
+		push_up(index);
+	}
+
+	// remove the best element from the heap
+	search::search_node*
+	pop()
+	{
+		if(queuesize_ == 0) { return nullptr; }
+		search::search_node* ans = elts_[0];
+		erase(0);
+		return ans;
+	}
+
+	// remove the worst element from the heap
+	search::search_node*
+	pop_max()
+	{
+		if(queuesize_ == 0) { return nullptr; }
+		unsigned int index       = max_index();
+		search::search_node* ans = elts_[index];
+		erase(index);
+		return ans;
+	}
+
+	// remove @param n from the heap, wherever it is
+	void
+	remove(search::search_node* n)
+	{
+		assert(contains(n));
+		erase(Index::get(n));
+	}
+
+	// @return true if heap contains search node @param n
+	// and return false if it does not
+	inline bool
+	contains(search::search_node* n)
+	{
+		unsigned int index = Index::get(n);
+		return index < queuesize_ && n == elts_[index];
+	}
+
+	// retrieve the best element without removing it
+	inline search::search_node*
+	peek()
+	{
+		if(queuesize_ > 0) { return elts_[0]; }
+		return nullptr;
+	}
+
+	// retrieve the worst element without removing it
+	inline search::search_node*
+	peek_max()
+	{
+		if(queuesize_ > 0) { return elts_[max_index()]; }
+		return nullptr;
+	}
+
+	uint32_t
+	get_heap_ops()
+	{
+		return heap_ops_;
+	}
+
+	inline uint32_t
+	size()
+	{
+		return queuesize_;
+	}
+
+	void
+	print(std::ostream& out)
+	{
+		for(unsigned int i = 0; i < queuesize_; i++)
+		{
+			elts_[i]->print(out);
+			out << std::endl;
+		}
+	}
+
+	size_t
+	mem()
+	{
+		return maxsize_ * sizeof(search::search_node*) + sizeof(*this);
+	}
+
+private:
+	unsigned int maxsize_;
+	unsigned int queuesize_;
+	search::search_node** elts_;
+	Comparator cmp_;
+	uint32_t heap_ops_;
+
+	// true if elts_[a] should be retrieved before elts_[b] by ::pop
+	inline bool
+	better(unsigned int a, unsigned int b)
+	{
+		return cmp_(*elts_[a], *elts_[b]);
+	}
+
+	// the root is on a min level; levels alternate from there
+	static inline bool
+	is_min_level(unsigned int index)
+	{
+		return (std::bit_width(index + 1) & 1) == 1;
+	}
+
+	inline unsigned int
+	max_index()
+	{
+		if(queuesize_ < 3) { return queuesize_ - 1; }
+		return better(1, 2) ? 2 : 1;
+	}
+
+	void
+	erase(unsigned int index)
+	{
+		assert(index < queuesize_);
+		queuesize_--;
+		if(index == queuesize_) { return; }
+		elts_[index] = elts_[queuesize_];
+		Index::set(elts_[index], index);
+		update(index);
+	}
+
+	// restore the heap property around an element whose key changed
+	void
+	update(unsigned int index)
+	{
+		search::search_node* val = elts_[index];
+		push_down(index);
+		push_up(Index::get(val));
+	}
+
+	void
+	push_up(unsigned int index)
+	{
+		heap_ops_++;
+		if(index == 0) { return; }
+		unsigned int parent = (index - 1) >> 1;
+		if(is_min_level(index))
+		{
+			if(better(parent, index))
+			{
+				swap(index, parent);
+				push_up_(parent, false);
+			}
+			else { push_up_(index, true); }
+		}
+		else
+		{
+			if(better(index, parent))
+			{
+				swap(index, parent);
+				push_up_(parent, true);
+			}
+			else { push_up_(index, false); }
+		}
+	}
+
+	// bubble up through grandparents; on min levels when @param min
+	// is true and on max levels otherwise
+	void
+	push_up_(unsigned int index, bool min)
+	{
+		while(index > 2)
+		{
+			unsigned int grandparent = (((index - 1) >> 1) - 1) >> 1;
+			if(min ? better(index, grandparent) : better(grandparent, index))
+			{
+				swap(index, grandparent);
+				index = grandparent;
+			}
+			else { break; }
+		}
+	}
+
+	void
+	push_down(unsigned int index)
+	{
+		heap_ops_++;
+		bool min = is_min_level(index);
+		while(true)
+		{
+			// find the best (min level) or worst (max level) element
+			// among the children and grandchildren of index
+			unsigned int first = (index << 1) + 1;
+			if(first >= queuesize_) { break; }
+			unsigned int which = first;
+			unsigned int candidates[6]
+			    = {first + 1,     (first << 1) + 1, (first << 1) + 2,
+			       (first << 1) + 3, (first << 1) + 4, 0};
+			for(unsigned int* c = candidates; *c != 0 && *c < queuesize_; c++)
+			{
+				if(min ? better(*c, which) : better(which, *c)) { which = *c; }
+			}
+
+			if(!(min ? better(which, index) : better(index, which))) { break; }
+			swap(index, which);
+			if(which <= first + 1) { break; } // a child; nothing below
+
+			// a grandchild; it may now be out of order with its parent
+			unsigned int parent = (which - 1) >> 1;
+			if(min ? better(parent, which) : better(which, parent))
+			{
+				swap(which, parent);
+			}
+			index = which;
+		}
+	}
+
+	// allocates more memory so the heap can grow
+	void
+	resize(unsigned int newsize)
+	{
+		newsize = newsize >= 4 ? newsize : 4;
+		assert(newsize >= queuesize_);
+
+		search::search_node** tmp = new search::search_node* [newsize] {};
+		for(unsigned int i = 0; i < queuesize_; i++)
+		{
+			tmp[i] = elts_[i];
+		}
+		delete[] elts_;
+		elts_    = tmp;
+		maxsize_ = newsize;
+	}
+
+	// swap the positions of two nodes in the underlying array
+	inline void
+	swap(unsigned int index1, unsigned int index2)
+	{
+		assert(index1 < queuesize_ && index2 < queuesize_);
+
+		search::search_node* tmp = elts_[index1];
+		elts_[index1]            = elts_[index2];
+		Index::set(elts_[index1], index1);
+		elts_[index2] = tmp;
+		Index::set(tmp, index2);
+	}
+};
+
+using minmax_heap_min = minmax_heap<search::cmp_less_search_node>;
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_MINMAX_HEAP_H
@@ -0,0 +1,205 @@
+#ifndef WARTHOG_UTIL_PACKED_PQUEUE_H
+#define WARTHOG_UTIL_PACKED_PQUEUE_H
+
+// util/packed_pqueue.h
+//
+// A min priority queue of search nodes ordered by a packed 64-bit key
+// (see search/tie_breaking.h). The key of each node is computed once,
+// when the node is pushed or its priority changes, and stored next to
+// the node pointer. Heap operations then need one integer comparison
+// per step and never touch the nodes themselves, except to update
+// their heap index (search_node::priority_).
+//
+// The interface is that of pqueue, so the queue can be used as the
+// OPEN list of unidirectional_search.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/search/search_node.h>
+#include <warthog/search/tie_breaking.h>
+#include <warthog/util/prefetch.h>
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace warthog::util
+{
+
+template<search::tie_breaking TB = search::tie_breaking::larger_g>
+class packed_pqueue
+{
+public:
+	packed_pqueue(unsigned int size = 1024) : seq_(0), heap_ops_(0)
+	{
+		elts_.reserve(size);
+	}
+
+	~packed_pqueue() { }
+
+	void
+	clear()
+	{
+		elts_.clear();
+		seq_      = 0;
+		heap_ops_ = 0;
+	}
+
+	// the priority of @param val improved; recompute its key
+	void
+	decrease_key(search::search_node* val)
+	{
+		assert(contains(val));
+		uint32_t index    = val->get_priority();
+		elts_[index].key_ = search::packed_key<TB>(*val, seq_++);
+		heapify_up(index);
+	}
+
+	void
+	increase_key(search::search_node* val)
+	{
+		assert(contains(val));
+		uint32_t index    = val->get_priority();
+		elts_[index].key_ = search::packed_key<TB>(*val, seq_++);
+		heapify_down(index);
+	}
+
+	void
+	push(search::search_node* val)
+	{
+		if(contains(val)) { return; }
+		uint32_t index = (uint32_t)elts_.size();
+		elts_.push_back({search::packed_key<TB>(*val, seq_++), val});
+		val->set_priority(index);
+		heapify_up(index);
+	}
+
+	search::search_node*
+	pop()
+	{
+		if(elts_.empty()) { return nullptr; }
+		search::search_node* ans = elts_[0].node_;
+		elts_[0]                 = elts_.back();
+		elts_.pop_back();
+		if(!elts_.empty())
+		{
+			elts_[0].node_->set_priority(0);
+			heapify_down(0);
+		}
+		return ans;
+	}
+
+	inline bool
+	contains(search::search_node* n)
+	{
+		uint32_t index = n->get_priority();
+		return index < elts_.size() && elts_[index].node_ == n;
+	}
+
+	inline search::search_node*
+	peek()
+	{
+		return elts_.empty() ? nullptr : elts_[0].node_;
+	}
+
+	uint32_t
+	get_heap_ops()
+	{
+		return heap_ops_;
+	}
+
+	inline uint32_t
+	size()
+	{
+		return (uint32_t)elts_.size();
+	}
+
+	inline bool
+	is_minqueue()
+	{
+		return true;
+	}
+
+	void
+	print(std::ostream& out)
+	{
+		for(auto& e : elts_)
+		{
+			out << "key " << e.key_ << " ";
+			e.node_->print(out);
+			out << std::endl;
+		}
+	}
+
+	size_t
+	mem()
+	{
+		return elts_.capacity() * sizeof(entry) + sizeof(*this);
+	}
+
+private:
+	struct entry
+	{
+		uint64_t key_;
+		search::search_node* node_;
+	};
+
+	std::vector<entry> elts_;
+	uint64_t seq_;
+	uint32_t heap_ops_;
+
+	void
+	heapify_up(uint32_t index)
+	{
+		heap_ops_++;
+		entry e = elts_[index];
+		while(index > 0)
+		{
+			uint32_t parent = (index - 1) >> 1;
+			if(!(e.key_ < elts_[parent].key_)) { break; }
+			place(index, elts_[parent]);
+			index = parent;
+		}
+		place(index, e);
+	}
+
+	void
+	heapify_down(uint32_t index)
+	{
+		heap_ops_++;
+		uint32_t size = (uint32_t)elts_.size();
+		entry e       = elts_[index];
+		while(true)
+		{
+			uint32_t child = (index << 1) + 1;
+			if(child >= size) { break; }
+			// the 4 grandchildren share a cache line or two
+			if(((index << 2) + 3) < size)
+			{
+				prefetch_hint(&elts_[(index << 2) + 3]);
+			}
+			if(child + 1 < size && elts_[child + 1].key_ < elts_[child].key_)
+			{
+				child++;
+			}
+			if(!(elts_[child].key_ < e.key_)) { break; }
+			place(index, elts_[child]);
+			index = child;
+		}
+		place(index, e);
+	}
+
+	inline void
+	place(uint32_t index, const entry& e)
+	{
+		elts_[index] = e;
+		e.node_->set_priority(index);
+	}
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_PACKED_PQUEUE_H
@@ -11,6 +11,7 @@
 //
 
 #include <warthog/search/search_node.h>
+#include <warthog/util/prefetch.h>
 
 #include <cassert>
 #include <iostream>
@@ -192,6 +193,16 @@ private:
 		unsigned int first_leaf_index = queuesize_ >> 1;
 		while(index < first_leaf_index)
 		{
+			// the nodes compared on the next level, if we get there
+			if constexpr(PREFETCH_HINTS)
+			{
+				unsigned int gc = (index << 2) + 3;
+				for(unsigned int i = gc; i < gc + 4 && i < queuesize_; i++)
+				{
+					prefetch_hint(elts_[i]);
+				}
+			}
+
 			// find smallest (or largest, depending on heap type) child
 			unsigned int child1 = (index << 1) + 1;
 			unsigned int child2 = (index << 1) + 2;
@@ -250,8 +261,9 @@ private:
 	}
 };
 
-using pqueue_min = pqueue<search::cmp_less_search_node, min_q>;
-using pqueue_max = pqueue<search::cmp_greater_search_node, max_q>;
+using pqueue_min   = pqueue<search::cmp_less_search_node, min_q>;
+using pqueue_max   = pqueue<search::cmp_greater_search_node, max_q>;
+using pqueue_min_h = pqueue<search::cmp_less_search_node_h_only, min_q>;
 
 }
 
@@ -0,0 +1,56 @@
+#ifndef WARTHOG_UTIL_PREFETCH_H
+#define WARTHOG_UTIL_PREFETCH_H
+
+// util/prefetch.h
+//
+// Software prefetch hints. A hint asks the cpu to start moving the cache
+// line holding an address toward the core without waiting for it; it
+// never faults and has no effect on program state, so any address
+// (including null) is safe. Compilers without __builtin_prefetch get a
+// no-op.
+//
+// ::prefetch always issues the hint. ::prefetch_hint is for the hot
+// paths of the library (open lists, node pool, expansion) and is only
+// active when configured with WARTHOG_PREFETCH; whether it pays off
+// depends on the map and the machine.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/defines.h>
+
+namespace warthog::util
+{
+
+#ifdef WARTHOG_PREFETCH_ENABLED
+constexpr bool PREFETCH_HINTS = true;
+#else
+constexpr bool PREFETCH_HINTS = false;
+#endif
+
+// hint that @param addr will be read soon
+inline void
+prefetch(const void* addr) noexcept
+{
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_prefetch)
+	__builtin_prefetch(addr, 0, 3);
+#else
+	(void)addr;
+#endif
+#else
+	(void)addr;
+#endif
+}
+
+// as ::prefetch, if WARTHOG_PREFETCH is enabled; otherwise nothing
+inline void
+prefetch_hint(const void* addr) noexcept
+{
+	if constexpr(PREFETCH_HINTS) { prefetch(addr); }
+}
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_PREFETCH_H
@@ -0,0 +1,147 @@
+#ifndef WARTHOG_UTIL_QUERY_LOG_H
+#define WARTHOG_UTIL_QUERY_LOG_H
+
+// util/query_log.h
+//
+// A compact binary log of the queries a program solves, with what was
+// observed solving them, so that real traffic can be replayed later to
+// reproduce and compare performance (warthog --alg replay).
+//
+// A log is the 8 bytes "WQLOG001" followed by entries, each starting
+// with a uint32_t tag:
+//  - MAP: the width, height and name length of a map, as uint32_t, then
+//    the name. maps are numbered from 0 in the order they appear.
+//  - QUERY: one query_record.
+// A map appears before the first query on it. Entries are written in
+// host byte order, as they are in memory.
+//
+// Queries are recorded by a query_recorder, given to a search through
+// search_parameters::set_recorder. Searches that take a recorder call
+// it when each query given to ::get_path is solved.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/search/problem_instance.h>
+#include <warthog/search/search_parameters.h>
+#include <warthog/search/solution.h>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace warthog::util
+{
+
+struct query_record
+{
+	uint64_t time_;  // nanos from the opening of the log to the query
+	uint32_t map_;   // as numbered by the log
+	uint32_t start_; // pack_id
+	uint32_t target_;
+	uint32_t exp_cutoff_; // search parameters
+	double weight_;
+	double cost_; // observed; COST_MAX if not solved
+	uint32_t expanded_;
+	uint32_t generated_;
+	uint64_t nanos_;
+};
+
+static_assert(sizeof(query_record) == 56);
+
+struct query_log_map
+{
+	std::string name_;
+	uint32_t width_;
+	uint32_t height_;
+};
+
+class query_log_writer
+{
+public:
+	// create the log @param filename. throws std::runtime_error if it
+	// cannot be written.
+	explicit query_log_writer(const char* filename);
+
+	// the number of the map @param name, of @param width by @param height
+	// cells; it is written to the log the first time it is asked for
+	uint32_t
+	add_map(const std::string& name, uint32_t width, uint32_t height);
+
+	// append @param r. safe to call from several threads. the log is
+	// flushed by the first write 100ms after the last flush, so a
+	// process that is killed loses little of it.
+	void
+	write(const query_record& r);
+
+	// nanos since the log was opened
+	uint64_t
+	now() const;
+
+	uint64_t
+	num_queries() const;
+
+	void
+	flush();
+
+private:
+	mutable std::mutex mutex_;
+	std::ofstream out_;
+	std::chrono::steady_clock::time_point opened_;
+	std::chrono::steady_clock::time_point flushed_;
+	std::unordered_map<std::string, uint32_t> maps_;
+	uint64_t queries_;
+};
+
+class query_log_reader
+{
+public:
+	// open the log @param filename. throws std::runtime_error if it
+	// cannot be read or is not a query log.
+	explicit query_log_reader(const char* filename);
+
+	// read the next query into @param r; false at the end of the log.
+	// throws std::runtime_error if the log is truncated or corrupt.
+	bool
+	next(query_record& r);
+
+	// the maps named so far
+	const std::vector<query_log_map>&
+	maps() const noexcept
+	{
+		return maps_;
+	}
+
+private:
+	std::ifstream in_;
+	std::vector<query_log_map> maps_;
+};
+
+// records the queries of one map to a log
+class query_recorder
+{
+public:
+	query_recorder(
+	    query_log_writer& log, const std::string& map, uint32_t width,
+	    uint32_t height)
+	    : log_(&log), map_(log.add_map(map, width, height))
+	{ }
+
+	void
+	record(
+	    const search::problem_instance& pi,
+	    const search::search_parameters& par, const search::solution& sol);
+
+private:
+	query_log_writer* log_;
+	uint32_t map_;
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_QUERY_LOG_H
@@ -11,6 +11,9 @@
 //	    - DIMACS format (as at the 9th DIMACS Implementation Challenge)
 //	      (fields: q [source-id] [target-id])
 //
+//	Files are read with scenario_reader. For very large files see also
+//	scenario_store, which holds queries more compactly.
+//
 //	Supported formats for generate/write:
 //	    - GPPC 1.0 format (as at 2012 Grid-based Path Planning Competition)
 //
@@ -26,11 +29,14 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 namespace warthog::util
 {
 
+class scenario_reader;
+
 class scenario_manager
 {
 public:
@@ -79,26 +85,50 @@ public:
 		experiments_.clear();
 	}
 
+	// add @param num instances between random connected cells of
+	// @param map. the optimal distance of generated instances is not
+	// known and is recorded as 0. the same @param seed gives the same
+	// instances.
 	void
-	generate_experiments(domain::gridmap*, int num);
+	generate_experiments(domain::gridmap* map, int num, uint32_t seed = 0);
 	void
 	load_scenario(const char* filelocation);
 	void
 	write_scenario(std::ostream& out);
 	void
-	sort(); // organise by increasing solution length
+	sort(); // organise by increasing solution length; stable
+
+	// move the experiments into one new manager per map, so that the
+	// instances of each map can be run together. managers are in order of
+	// the first instance of their map and keep the order of the instances.
+	// the index in this manager of each instance is written to
+	// @param index, one list per map, if given. this manager is left empty.
+	std::vector<std::unique_ptr<scenario_manager>>
+	split_by_map(std::vector<std::vector<uint32_t>>* index = nullptr);
+
+	// move the experiments, in order, into new managers of at most
+	// @param size each. this manager is left empty.
+	std::vector<std::unique_ptr<scenario_manager>>
+	split_by_size(uint32_t size);
+
+	// number of distinct maps named by the experiments
+	uint32_t
+	num_maps() const;
 
 private:
 	void
-	load_gppc_scenario(std::ifstream& infile);
+	load_gppc_scenario(scenario_reader& reader);
 
 	std::vector<experiment*> experiments_;
 	std::string sfile_;
 };
 
+// the map of experiment @param which of @param scenmgr, as named in the
+// scenario file or else deduced from the name of the scenario file
 std::filesystem::path
 find_map_filename(
-    const scenario_manager& scenmgr, std::filesystem::path sfilename = {});
+    const scenario_manager& scenmgr, std::filesystem::path sfilename = {},
+    uint32_t which = 0);
 
 } // namespace warthog::util
 
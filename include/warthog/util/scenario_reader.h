@@ -0,0 +1,79 @@
+#ifndef WARTHOG_UTIL_SCENARIO_READER_H
+#define WARTHOG_UTIL_SCENARIO_READER_H
+
+// util/scenario_reader.h
+//
+// Stream the queries of a GPPC 1.0 scenario file (see scenario_manager)
+// one at a time, without holding them all in memory. The file is mapped
+// into memory and parsed in place: one line per query, with the fields
+// bucket, map, mapwidth, mapheight, sx, sy, gx, gy and distance separated
+// by spaces or tabs.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace warthog::util
+{
+
+class scenario_reader
+{
+public:
+	struct query
+	{
+		uint32_t bucket_;
+		std::string_view map_; // points into the file
+		uint32_t mapwidth_;
+		uint32_t mapheight_;
+		uint32_t startx_;
+		uint32_t starty_;
+		uint32_t goalx_;
+		uint32_t goaly_;
+		double distance_;
+		int32_t precision_; // digits after the point of distance_
+	};
+
+	// open @param filename. throws std::runtime_error if it cannot be
+	// read or is not a GPPC 1.0 scenario file.
+	explicit scenario_reader(const char* filename);
+	scenario_reader(const scenario_reader&) = delete;
+	~scenario_reader();
+
+	scenario_reader&
+	operator=(const scenario_reader&)
+	    = delete;
+
+	// read the next query into @param q. returns false at the end of the
+	// file; throws std::runtime_error, naming the line, if the line is
+	// malformed. q.map_ is valid for as long as the reader.
+	bool
+	next(query& q);
+
+	// the line last read, from 1
+	uint64_t
+	line() const noexcept
+	{
+		return line_;
+	}
+
+	// the size of the file, in bytes
+	size_t
+	size() const noexcept
+	{
+		return size_;
+	}
+
+private:
+	const char* data_;
+	size_t size_;
+	const char* pos_;
+	uint64_t line_;
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_SCENARIO_READER_H
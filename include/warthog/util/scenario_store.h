@@ -0,0 +1,162 @@
+#ifndef WARTHOG_UTIL_SCENARIO_STORE_H
+#define WARTHOG_UTIL_SCENARIO_STORE_H
+
+// util/scenario_store.h
+//
+// A compact store for the queries of large scenario files. Each field
+// of the queries is kept in an array of its own, and the name and size
+// of each map are stored once and referred to by number. A query takes
+// 29 bytes, against a heap-allocated experiment with its own copy of
+// the map name in scenario_manager.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/search/problem_instance.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace warthog::util
+{
+
+class scenario_store
+{
+public:
+	// add the queries of the GPPC 1.0 scenario file @param filename.
+	// throws std::runtime_error if it cannot be read or is malformed.
+	void
+	load(const char* filename);
+
+	void
+	add(uint32_t sx, uint32_t sy, uint32_t gx, uint32_t gy, double distance,
+	    int32_t precision, std::string_view map, uint32_t mapwidth,
+	    uint32_t mapheight);
+
+	uint32_t
+	size() const noexcept
+	{
+		return (uint32_t)startx_.size();
+	}
+
+	uint32_t
+	startx(uint32_t i) const noexcept
+	{
+		return startx_[i];
+	}
+
+	uint32_t
+	starty(uint32_t i) const noexcept
+	{
+		return starty_[i];
+	}
+
+	uint32_t
+	goalx(uint32_t i) const noexcept
+	{
+		return goalx_[i];
+	}
+
+	uint32_t
+	goaly(uint32_t i) const noexcept
+	{
+		return goaly_[i];
+	}
+
+	double
+	distance(uint32_t i) const noexcept
+	{
+		return distance_[i];
+	}
+
+	int32_t
+	precision(uint32_t i) const noexcept
+	{
+		return precision_[i];
+	}
+
+	// the number of the map of query @param i; queries on maps with the
+	// same name and size have the same number
+	uint32_t
+	map_id(uint32_t i) const noexcept
+	{
+		return map_[i];
+	}
+
+	const std::string&
+	map(uint32_t i) const noexcept
+	{
+		return maps_[map_[i]].name_;
+	}
+
+	uint32_t
+	mapwidth(uint32_t i) const noexcept
+	{
+		return maps_[map_[i]].width_;
+	}
+
+	uint32_t
+	mapheight(uint32_t i) const noexcept
+	{
+		return maps_[map_[i]].height_;
+	}
+
+	uint32_t
+	num_maps() const noexcept
+	{
+		return (uint32_t)maps_.size();
+	}
+
+	search::problem_instance
+	get_instance(uint32_t i) const noexcept
+	{
+		uint32_t width = mapwidth(i);
+		return search::problem_instance(
+		    pack_id{starty_[i] * width + startx_[i]},
+		    pack_id{goaly_[i] * width + goalx_[i]});
+	}
+
+	// order by increasing distance. queries of equal distance keep their
+	// order.
+	void
+	sort();
+
+	void
+	clear();
+
+	size_t
+	mem() const noexcept;
+
+private:
+	struct map_entry
+	{
+		std::string name_;
+		uint32_t width_;
+		uint32_t height_;
+		uint32_t next_; // another map of the same name, or NONE
+	};
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	std::vector<uint32_t> startx_;
+	std::vector<uint32_t> starty_;
+	std::vector<uint32_t> goalx_;
+	std::vector<uint32_t> goaly_;
+	std::vector<double> distance_;
+	std::vector<int8_t> precision_;
+	std::vector<uint32_t> map_;
+
+	std::vector<map_entry> maps_;
+	std::unordered_map<std::string, uint32_t> by_name_; // first of a name
+	uint32_t last_ = NONE;                              // map last added
+
+	uint32_t
+	intern_(std::string_view name, uint32_t width, uint32_t height);
+};
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_SCENARIO_STORE_H
@@ -0,0 +1,74 @@
+#ifndef WARTHOG_UTIL_TUNING_PROFILE_H
+#define WARTHOG_UTIL_TUNING_PROFILE_H
+
+// util/tuning_profile.h
+//
+// The search configuration found to be fastest on one map, together
+// with the statistics of that map. Profiles are written by the tuner
+// (warthog --alg tune) and read back to configure A* for the same map.
+//
+// The file format is one "key value" pair per line; blank lines and
+// lines starting with # are ignored. Example:
+//  queue packed
+//  tiebreak h
+//  heuristic eager
+//  movetable 1
+//  width 512
+//  height 512
+//  traversable 180234
+//  ...
+//  cost_model 0.8 1.1 2.5 0 74.2
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/domain/gridmap.h>
+#include <warthog/domain/map_stats.h>
+#include <warthog/search/cost_predictor.h>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace warthog::util
+{
+
+struct tuning_profile
+{
+	std::string queue_    = "binary"; // binary, packed or lazy
+	std::string tiebreak_ = "g";      // g, h, lifo or fifo; not for binary
+	bool lazy_h_          = false;    // lazy heuristic evaluation
+	bool movetable_       = false;    // precomputed legal moves
+
+	// the map the profile was made for
+	domain::map_stats stats_;
+
+	// query costs on the map, with the configuration above
+	search::cost_model model_;
+
+	// a short name for the configuration, e.g. packed-h-eager-movetable
+	std::string
+	name() const;
+
+	// true if @param map has the size and number of traversable cells
+	// of the map the profile was made for
+	bool
+	matches(const domain::gridmap& map) const;
+
+	// read a profile from @param filename. returns false, with a message
+	// on std::cerr, if the file is missing or has invalid entries.
+	bool
+	load(const char* filename);
+
+	void
+	save(std::ostream& out) const;
+};
+
+// the default location of the profile of @param mapfile
+std::filesystem::path
+profile_filename(const std::filesystem::path& mapfile);
+
+} // namespace warthog::util
+
+#endif // WARTHOG_UTIL_TUNING_PROFILE_H
@@ -0,0 +1,120 @@
+#include <warthog/domain/grid_components.h>
+
+#include <algorithm>
+
+namespace warthog::domain
+{
+
+grid_components::grid_components(const gridmap& map)
+{
+	build(map);
+}
+
+void
+grid_components::build(const gridmap& map)
+{
+	label_.assign(map.padded_mapsize(), NONE);
+	size_.clear();
+	parent_.clear();
+
+	// flood fill from each unlabelled cell. the map is padded with
+	// blocked cells on every side, so the neighbours of a traversable
+	// cell are always within the map.
+	const uint32_t width = map.width();
+	std::vector<uint32_t> stack;
+	for(uint32_t id = 0; id < map.padded_mapsize(); id++)
+	{
+		if(label_[id] != NONE || !map.get_label(pad_id{id})) { continue; }
+
+		uint32_t c    = (uint32_t)size_.size();
+		uint32_t size = 0;
+		label_[id]    = c;
+		stack.push_back(id);
+		while(!stack.empty())
+		{
+			uint32_t cur = stack.back();
+			stack.pop_back();
+			size++;
+			for(uint32_t n : {cur - width, cur - 1, cur + 1, cur + width})
+			{
+				if(label_[n] == NONE && map.get_label(pad_id{n}))
+				{
+					label_[n] = c;
+					stack.push_back(n);
+				}
+			}
+		}
+		size_.push_back(size);
+		parent_.push_back(c);
+	}
+	count_ = (uint32_t)size_.size();
+}
+
+bool
+grid_components::update(
+    const gridmap& map, uint32_t x, uint32_t y, uint32_t width,
+    uint32_t height)
+{
+	x      = std::min(x, map.header_width());
+	y      = std::min(y, map.header_height());
+	width  = std::min(width, map.header_width() - x);
+	height = std::min(height, map.header_height() - y);
+	for(uint32_t row = y; row < y + height; row++)
+	{
+		uint32_t id = map.to_padded_id_from_unpadded(x, row).id;
+		for(uint32_t end = id + width; id < end; id++)
+		{
+			if(label_[id] != NONE && !map.get_label(pad_id{id}))
+			{
+				build(map);
+				return false;
+			}
+		}
+	}
+
+	// each opened cell starts a component of its own and is merged with
+	// those of its traversable neighbours, including cells opened before
+	const uint32_t map_width = map.width();
+	for(uint32_t row = y; row < y + height; row++)
+	{
+		uint32_t id = map.to_padded_id_from_unpadded(x, row).id;
+		for(uint32_t end = id + width; id < end; id++)
+		{
+			if(label_[id] != NONE || !map.get_label(pad_id{id})) { continue; }
+			uint32_t c = (uint32_t)size_.size();
+			label_[id] = c;
+			size_.push_back(1);
+			parent_.push_back(c);
+			count_++;
+			for(uint32_t n : {id - map_width, id - 1, id + 1, id + map_width})
+			{
+				if(label_[n] == NONE) { continue; }
+				merge_(get(pad_id{id}), get(pad_id{n}));
+			}
+		}
+	}
+	return true;
+}
+
+void
+grid_components::merge_(uint32_t a, uint32_t b)
+{
+	if(a == b) { return; }
+	if(size_[a] < size_[b]) { std::swap(a, b); }
+	parent_[b] = a;
+	size_[a] += size_[b];
+	count_--;
+}
+
+uint32_t
+grid_components::largest() const noexcept
+{
+	uint32_t best = 0;
+	for(uint32_t c = 0; c < size_.size(); c++)
+	{
+		if(parent_[c] == c) { best = std::max(best, size_[c]); }
+	}
+	return best;
+}
+
+} // namespace warthog::domain
@@ -1,5 +1,6 @@
 #include <warthog/domain/gridmap.h>
 
+#include <algorithm>
 #include <bit>
 #include <cassert>
 #include <cstring>
@@ -12,6 +13,8 @@ namespace warthog::domain
 
 gridmap::gridmap(unsigned int h, unsigned int w) : header_(h, w, "octile")
 {
+	filename_[0]     = '\0';
+	num_traversable_ = 0;
 	this->init_db();
 }
 
@@ -62,7 +65,7 @@ gridmap::init_db()
 	this->db_size_ = bittable::calc_array_size(store_width, store_height) + 8;
 
 	// create a one dimensional dbword array to store the grid
-	this->db_ = new warthog::dbword[db_size_];
+	this->db_ = new warthog::dbword[db_size_](); // incl. the 8 spare words
 	bittable::setup(this->db_, store_width, store_height);
 	fill(0);
 
@@ -74,6 +77,52 @@ gridmap::~gridmap()
 	delete[] db_;
 }
 
+void
+gridmap::set_row(uint32_t x, uint32_t y, const uint64_t* bits, uint32_t count)
+{
+	assert(x + count <= header_.width_ && y < header_.height_);
+	uint32_t first = to_padded_id_from_unpadded(x, y).id;
+	for(uint32_t done = 0; done < count;)
+	{
+		// the next n cells, up to the end of the 64-bit word holding
+		// cell bit, taken from bits at offset done
+		uint32_t bit = first + done;
+		uint32_t off = bit & 63;
+		uint32_t n   = std::min(64 - off, count - done);
+		uint32_t i   = done >> 6;
+		uint32_t s   = done & 63;
+		uint64_t src = bits[i] >> s;
+		if(s != 0 && s + n > 64) { src |= bits[i + 1] << (64 - s); }
+		uint64_t mask = (n == 64 ? ~0ull : ((1ull << n) - 1)) << off;
+
+		warthog::dbword* pos = db_ + ((bit >> 6) << 3);
+		uint64_t word;
+		std::memcpy(&word, pos, sizeof(word));
+		uint64_t next = (word & ~mask) | ((src << off) & mask);
+		num_traversable_ += std::popcount(next) - std::popcount(word);
+		std::memcpy(pos, &next, sizeof(next));
+		done += n;
+	}
+}
+
+void
+gridmap::copy_rows(const gridmap& other, uint32_t first, uint32_t count)
+{
+	assert(other.dbwidth_ == dbwidth_ && other.dbheight_ == dbheight_);
+	assert(first + count <= dbheight_);
+	const warthog::dbword* from = other.db_ + first * dbwidth_;
+	warthog::dbword* to         = db_ + first * dbwidth_;
+	size_t words                = (size_t)count * dbwidth_;
+
+	auto popcount = [words](const warthog::dbword* w) {
+		return std::transform_reduce(
+		    w, w + words, 0u, std::plus<uint32_t>(),
+		    [](warthog::dbword v) { return (uint32_t)std::popcount(v); });
+	};
+	num_traversable_ = num_traversable_ - popcount(to) + popcount(from);
+	std::memcpy(to, from, words * sizeof(warthog::dbword));
+}
+
 void
 gridmap::print(std::ostream& out)
 {
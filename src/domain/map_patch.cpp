@@ -0,0 +1,104 @@
+#include <warthog/domain/map_patch.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace warthog::domain
+{
+
+namespace
+{
+
+bool
+fits(uint32_t width, uint32_t height, const io::grid_patch& patch)
+{
+	return patch.x_ <= width && patch.width_ <= width - patch.x_
+	    && patch.y_ <= height && patch.height_ <= height - patch.y_
+	    && patch.cells_.size() >= (size_t)patch.width_ * patch.height_;
+}
+
+} // namespace
+
+bool
+apply_patch(gridmap& map, const io::grid_patch& patch)
+{
+	if(!fits(map.header_width(), map.header_height(), patch)) { return false; }
+
+	// convert the whole patch first, so a bad cell changes nothing
+	uint32_t words = (patch.width_ + 63) / 64;
+	std::vector<uint64_t> bits((size_t)words * patch.height_, 0);
+	for(uint32_t y = 0; y < patch.height_; y++)
+	{
+		const char* row = patch.row(y);
+		uint64_t* out   = bits.data() + (size_t)y * words;
+		for(uint32_t x = 0; x < patch.width_; x++)
+		{
+			io::bittable_cell cell = io::bittable_serialize::cell_type(row[x]);
+			if(cell == io::bittable_cell::UNKNOWN) { return false; }
+			if(cell == io::bittable_cell::TRAVERSABLE)
+			{
+				out[x >> 6] |= 1ull << (x & 63);
+			}
+		}
+	}
+	for(uint32_t y = 0; y < patch.height_; y++)
+	{
+		map.set_row(
+		    patch.x_, patch.y_ + y, bits.data() + (size_t)y * words,
+		    patch.width_);
+	}
+	return true;
+}
+
+bool
+apply_patch(vl_gridmap& map, const io::grid_patch& patch)
+{
+	if(!fits(map.header_width(), map.header_height(), patch)) { return false; }
+
+	std::vector<warthog::dbword> labels(patch.width_);
+	for(uint32_t y = 0; y < patch.height_; y++)
+	{
+		const char* row = patch.row(y);
+		for(uint32_t x = 0; x < patch.width_; x++)
+		{
+			labels[x] = (warthog::dbword)row[x];
+		}
+		map.set_row(patch.x_, patch.y_ + y, labels.data(), patch.width_);
+	}
+	return true;
+}
+
+uint32_t
+apply_patches(
+    std::istream& in, gridmap& map, move_table* moves,
+    grid_components* components)
+{
+	io::bittable_serialize parser;
+	if(!parser.read_header(in)
+	   || parser.get_type() != io::bittable_type::PATCH)
+	{
+		throw std::runtime_error("invalid patch format");
+	}
+
+	io::grid_patch patch;
+	uint32_t applied = 0;
+	for(; applied < parser.get_patch_count(); applied++)
+	{
+		if(!parser.read_patch(in, patch) || !apply_patch(map, patch))
+		{
+			throw std::runtime_error("invalid patch format");
+		}
+		if(moves)
+		{
+			moves->update(map, patch.x_, patch.y_, patch.width_, patch.height_);
+		}
+		if(components)
+		{
+			components->update(
+			    map, patch.x_, patch.y_, patch.width_, patch.height_);
+		}
+	}
+	return applied;
+}
+
+} // namespace warthog::domain
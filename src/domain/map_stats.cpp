@@ -0,0 +1,36 @@
+#include <warthog/domain/map_stats.h>
+
+namespace warthog::domain
+{
+
+map_stats::map_stats(const gridmap& map, const grid_components& components)
+    : width_(map.header_width()), height_(map.header_height()),
+      components_(components.num_components())
+{
+	const uint32_t width = map.width();
+	uint32_t corridors   = 0;
+	for(uint32_t y = 0; y < height_; y++)
+	{
+		for(uint32_t x = 0; x < width_; x++)
+		{
+			uint32_t id = map.to_padded_id_from_unpadded(x, y).id;
+			if(!map.get_label(pad_id{id})) { continue; }
+			traversable_++;
+			uint32_t open = map.get_label(pad_id{id - width})
+			    + map.get_label(pad_id{id - 1})
+			    + map.get_label(pad_id{id + 1})
+			    + map.get_label(pad_id{id + width});
+			if(open <= 2) { corridors++; }
+		}
+	}
+
+	uint64_t cells    = (uint64_t)width_ * height_;
+	obstacle_density_ = cells ? 1.0 - (double)traversable_ / cells : 0;
+	if(traversable_)
+	{
+		largest_share_  = (double)components.largest() / traversable_;
+		corridor_ratio_ = (double)corridors / traversable_;
+	}
+}
+
+} // namespace warthog::domain
@@ -0,0 +1,113 @@
+#include <warthog/domain/grid.h>
+#include <warthog/domain/move_table.h>
+
+#include <algorithm>
+
+namespace warthog::domain
+{
+
+namespace
+{
+
+// bit k of the result is the cell west (east) of bit k of @param cur;
+// @param prev and @param next are the words before and after it
+inline uint64_t
+west_of(uint64_t prev, uint64_t cur)
+{
+	return (cur << 1) | (prev >> 63);
+}
+
+inline uint64_t
+east_of(uint64_t cur, uint64_t next)
+{
+	return (cur >> 1) | (next << 63);
+}
+
+} // namespace
+
+move_table::move_table(const gridmap& map)
+{
+	build(map);
+}
+
+void
+move_table::build(const gridmap& map)
+{
+	moves_.assign(map.padded_mapsize(), 0);
+
+	// the padded map is one bit string, row after row, so the cell west
+	// of a row's first cell is the (blocked) padding at the end of the
+	// previous row. padding rows have no moves and are skipped; this
+	// also keeps every read within the map.
+	uint32_t first = gridmap::PADDED_ROWS * map.width();
+	uint32_t last  = map.padded_mapsize() - gridmap::PADDED_ROWS * map.width();
+	for(uint32_t id = first; id < last; id += 64)
+	{
+		compute_(map, id);
+	}
+}
+
+void
+move_table::update(
+    const gridmap& map, uint32_t x, uint32_t y, uint32_t width,
+    uint32_t height)
+{
+	// the moves of a cell depend on its 8 neighbours, so the cells
+	// around the rectangle change too. whole words of 64 cells are
+	// recomputed; rows are a multiple of 64 cells wide.
+	uint32_t y0 = y == 0 ? 0 : y - 1;
+	uint32_t y1 = std::min(y + height + 1, map.header_height());
+	uint32_t x0 = (x == 0 ? 0 : x - 1) & ~63u;
+	uint32_t x1 = std::min(x + width + 1, map.header_width());
+	for(uint32_t row = y0; row < y1; row++)
+	{
+		uint32_t start = map.to_padded_id_from_unpadded(0, row).id;
+		for(uint32_t col = x0; col < x1; col += 64)
+		{
+			compute_(map, start + col);
+		}
+	}
+}
+
+void
+move_table::compute_(const gridmap& map, uint32_t id)
+{
+	// rows above (0), at (1) and below (2) the 64 cells from id
+	uint64_t prev[3], cur[3], next[3];
+	map.get_neighbours_64bit(pad_id{id - 64}, prev);
+	map.get_neighbours_64bit(pad_id{id}, cur);
+	map.get_neighbours_64bit(pad_id{id + 64}, next);
+
+	uint64_t self = cur[1];
+	uint64_t n    = cur[0];
+	uint64_t s    = cur[2];
+	uint64_t e    = east_of(cur[1], next[1]);
+	uint64_t w    = west_of(prev[1], cur[1]);
+
+	uint64_t dir[8];
+	dir[grid::NORTH_ID]     = self & n;
+	dir[grid::SOUTH_ID]     = self & s;
+	dir[grid::EAST_ID]      = self & e;
+	dir[grid::WEST_ID]      = self & w;
+	dir[grid::NORTHEAST_ID] = dir[grid::NORTH_ID] & e
+	    & east_of(cur[0], next[0]);
+	dir[grid::NORTHWEST_ID] = dir[grid::NORTH_ID] & w
+	    & west_of(prev[0], cur[0]);
+	dir[grid::SOUTHEAST_ID] = dir[grid::SOUTH_ID] & e
+	    & east_of(cur[2], next[2]);
+	dir[grid::SOUTHWEST_ID] = dir[grid::SOUTH_ID] & w
+	    & west_of(prev[2], cur[2]);
+
+	// transpose: byte k collects bit k of every direction
+	for(uint32_t k = 0; k < 64; k++)
+	{
+		uint8_t m = 0;
+		for(uint32_t d = 0; d < 8; d++)
+		{
+			m |= static_cast<uint8_t>(((dir[d] >> k) & 1) << d);
+		}
+		moves_[id + k] = m;
+	}
+}
+
+} // namespace warthog::domain
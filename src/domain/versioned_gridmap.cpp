@@ -0,0 +1,162 @@
+#include <warthog/domain/versioned_gridmap.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace warthog::domain
+{
+
+versioned_gridmap::versioned_gridmap(const gridmap& map)
+    : width_(map.header_width()), height_(map.header_height()),
+      blocks_copied_(0)
+{
+	auto first  = std::make_unique<version>();
+	first->map_ = std::make_unique<gridmap>(height_, width_);
+	first->map_->copy_rows(map, 0, map.height());
+	current_.store(first.get());
+	versions_.push_back(std::move(first));
+	block_changed_.assign((map.height() + BLOCK_ROWS - 1) / BLOCK_ROWS, 0);
+}
+
+versioned_gridmap::~versioned_gridmap()
+{
+	for([[maybe_unused]] auto& v : versions_)
+	{
+		assert(v->readers_.load() == 0);
+	}
+}
+
+versioned_gridmap::snapshot
+versioned_gridmap::acquire() const
+{
+	while(true)
+	{
+		version* v = current_.load();
+		v->readers_.fetch_add(1);
+		// if v was replaced before it was counted it may be being reused
+		// by a writer; back off and take the new version instead
+		if(current_.load() == v) { return snapshot(v); }
+		v->readers_.fetch_sub(1);
+	}
+}
+
+uint64_t
+versioned_gridmap::commit(const std::vector<edit>& edits)
+{
+	std::lock_guard<std::mutex> lock(write_mutex_);
+	uint64_t number = current_.load()->number_ + 1;
+	version* next   = reuse_();
+	for(const edit& e : edits)
+	{
+		if(e.x_ >= width_ || e.y_ >= height_) { continue; }
+		next->map_->set_label(e.x_, e.y_, e.label_);
+		block_changed_[(e.y_ + gridmap::PADDED_ROWS) / BLOCK_ROWS] = number;
+	}
+	next->number_ = number;
+	current_.store(next);
+	reclaim_();
+	return number;
+}
+
+versioned_gridmap::version*
+versioned_gridmap::reuse_()
+{
+	version* current = current_.load();
+
+	// the most recent unused copy has the fewest blocks to bring up to
+	// date. a reader that counts itself on a version after this check
+	// sees that it is not current and backs off.
+	version* next = nullptr;
+	for(auto& v : versions_)
+	{
+		if(v.get() == current || v->readers_.load() != 0) { continue; }
+		if(!next || (v->map_ && !next->map_)
+		   || (v->map_ && v->number_ > next->number_))
+		{
+			next = v.get();
+		}
+	}
+	if(!next)
+	{
+		versions_.push_back(std::make_unique<version>());
+		next = versions_.back().get();
+	}
+
+	gridmap& cur = *current->map_;
+	if(!next->map_)
+	{
+		next->map_ = std::make_unique<gridmap>(height_, width_);
+		next->map_->copy_rows(cur, 0, cur.height());
+		blocks_copied_ += block_changed_.size();
+		return next;
+	}
+	for(uint32_t b = 0; b < block_changed_.size(); b++)
+	{
+		if(block_changed_[b] <= next->number_) { continue; }
+		uint32_t first = b * BLOCK_ROWS;
+		next->map_->copy_rows(
+		    cur, first, std::min(BLOCK_ROWS, cur.height() - first));
+		blocks_copied_++;
+	}
+	return next;
+}
+
+void
+versioned_gridmap::reclaim_()
+{
+	// the spare kept is the most recent, the cheapest to bring up to date
+	version* current = current_.load();
+	std::vector<version*> unused;
+	for(auto& v : versions_)
+	{
+		if(v.get() != current && v->map_ && v->readers_.load() == 0)
+		{
+			unused.push_back(v.get());
+		}
+	}
+	if(unused.size() < 2) { return; }
+	auto spare = std::max_element(
+	    unused.begin(), unused.end(),
+	    [](version* a, version* b) { return a->number_ < b->number_; });
+	for(version* v : unused)
+	{
+		if(v != *spare) { v->map_.reset(); }
+	}
+}
+
+uint64_t
+versioned_gridmap::get_version() const
+{
+	std::lock_guard<std::mutex> lock(write_mutex_);
+	return current_.load()->number_;
+}
+
+uint32_t
+versioned_gridmap::num_copies() const
+{
+	std::lock_guard<std::mutex> lock(write_mutex_);
+	return (uint32_t)std::count_if(
+	    versions_.begin(), versions_.end(),
+	    [](const auto& v) { return v->map_ != nullptr; });
+}
+
+uint64_t
+versioned_gridmap::get_blocks_copied() const
+{
+	std::lock_guard<std::mutex> lock(write_mutex_);
+	return blocks_copied_;
+}
+
+size_t
+versioned_gridmap::mem() const
+{
+	std::lock_guard<std::mutex> lock(write_mutex_);
+	size_t bytes = sizeof(*this) + block_changed_.capacity() * sizeof(uint64_t);
+	for(auto& v : versions_)
+	{
+		bytes += sizeof(version) + (v->map_ ? v->map_->mem() : 0);
+	}
+	return bytes;
+}
+
+} // namespace warthog::domain
@@ -45,4 +45,21 @@ bittable_serialize::read_header(std::istream& in)
 	return true;
 }
 
+bool
+bittable_serialize::read_patch(std::istream& in, grid_patch& patch)
+{
+	if(m_type != bittable_type::PATCH) return false;
+	if(!(in >> patch.x_ >> patch.y_)) return false;
+	patch.width_  = m_dim.width;
+	patch.height_ = m_dim.height;
+	patch.cells_.resize((size_t)m_dim.width * m_dim.height);
+	for(uint32_t y = 0; y < m_dim.height; ++y)
+	{
+		in >> std::ws;
+		char* row = patch.cells_.data() + (size_t)y * m_dim.width;
+		if(!in.read(row, m_dim.width)) return false;
+	}
+	return true;
+}
+
 } // namespace warthog::io
@@ -0,0 +1,206 @@
+#include <warthog/search/compact_path.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+
+namespace warthog::search
+{
+
+namespace
+{
+
+void
+write_u32(std::ostream& out, uint32_t value)
+{
+	char buf[4] = {
+	    static_cast<char>(value), static_cast<char>(value >> 8),
+	    static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+	out.write(buf, 4);
+}
+
+bool
+read_u32(std::istream& in, uint32_t& value)
+{
+	unsigned char buf[4];
+	if(!in.read(reinterpret_cast<char*>(buf), 4)) { return false; }
+	value = uint32_t{buf[0]} | (uint32_t{buf[1]} << 8)
+	    | (uint32_t{buf[2]} << 16) | (uint32_t{buf[3]} << 24);
+	return true;
+}
+
+} // namespace
+
+void
+compact_path::push_back(grid::direction_id dir, uint32_t length)
+{
+	assert(static_cast<uint8_t>(dir) < 8);
+	if(length == 0) { return; }
+	steps_ += length;
+	advance_(dir, length);
+
+	// top up the last run, if it heads the same way
+	if(!runs_.empty() && (runs_.back() & DIR_MASK) == dir)
+	{
+		uint32_t have = (uint32_t{runs_.back()} >> DIR_BITS) + 1;
+		uint32_t add  = std::min(length, MAX_RUN - have);
+		runs_.back() += static_cast<uint16_t>(add << DIR_BITS);
+		length       -= add;
+	}
+	while(length > 0)
+	{
+		uint32_t add = std::min(length, MAX_RUN);
+		runs_.push_back(static_cast<uint16_t>(((add - 1) << DIR_BITS) | dir));
+		length -= add;
+	}
+}
+
+bool
+compact_path::push_back_cell(pack_id next)
+{
+	assert(!empty() && width_ != 0);
+	pack_id last = back();
+	int32_t dx   = static_cast<int32_t>(uint32_t{next} % width_)
+	    - static_cast<int32_t>(uint32_t{last} % width_);
+	int32_t dy = static_cast<int32_t>(uint32_t{next} / width_)
+	    - static_cast<int32_t>(uint32_t{last} / width_);
+	if(std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0))
+	{
+		return false;
+	}
+	push_back(grid::dir_id_from_delta(dx, dy));
+	return true;
+}
+
+void
+compact_path::reverse(pack_id start)
+{
+	// the path was built from its last cell, which is now known
+	back_  = start_;
+	start_ = start;
+	std::reverse(runs_.begin(), runs_.end());
+}
+
+bool
+compact_path::encode(const std::vector<pack_id>& path, uint32_t width)
+{
+	clear();
+	if(path.empty()) { return true; }
+	reset(path.front(), width);
+	for(size_t i = 1; i < path.size(); i++)
+	{
+		if(!push_back_cell(path[i]))
+		{
+			clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+compact_path::decode(std::vector<pack_id>& path) const
+{
+	if(empty()) { return; }
+	path.reserve(path.size() + size());
+	int32_t x = static_cast<int32_t>(uint32_t{start_} % width_);
+	int32_t y = static_cast<int32_t>(uint32_t{start_} / width_);
+	path.push_back(start_);
+	for(uint16_t word : runs_)
+	{
+		auto dir       = static_cast<grid::direction_id>(word & DIR_MASK);
+		int32_t dx     = grid::dir_id_dx(dir);
+		int32_t dy     = grid::dir_id_dy(dir);
+		uint32_t steps = (uint32_t{word} >> DIR_BITS) + 1;
+		for(uint32_t i = 0; i < steps; i++)
+		{
+			x += dx;
+			y += dy;
+			path.push_back(pack_id{static_cast<uint32_t>(y) * width_ + x});
+		}
+	}
+}
+
+cost_t
+compact_path::cost() const noexcept
+{
+	uint64_t straight = 0, diagonal = 0;
+	for(uint16_t word : runs_)
+	{
+		auto dir       = static_cast<grid::direction_id>(word & DIR_MASK);
+		uint32_t steps = (uint32_t{word} >> DIR_BITS) + 1;
+		if(dir >= grid::NORTHEAST_ID) { diagonal += steps; }
+		else { straight += steps; }
+	}
+	return static_cast<cost_t>(straight + diagonal * warthog::DBL_ROOT_TWO);
+}
+
+void
+compact_path::write(std::ostream& out) const
+{
+	write_u32(out, static_cast<uint32_t>(start_.id));
+	write_u32(out, width_);
+	write_u32(out, static_cast<uint32_t>(runs_.size()));
+	for(uint16_t word : runs_)
+	{
+		char buf[2] = {static_cast<char>(word), static_cast<char>(word >> 8)};
+		out.write(buf, 2);
+	}
+}
+
+bool
+compact_path::read(std::istream& in)
+{
+	clear();
+	uint32_t start, width, num_runs;
+	if(!read_u32(in, start) || !read_u32(in, width) || !read_u32(in, num_runs))
+	{
+		return false;
+	}
+	// a path that has a start needs a width to decode its cells
+	if(width == 0 && start != UINT32_MAX) { return false; }
+	reset(start == UINT32_MAX ? pack_id::max() : pack_id{start}, width);
+
+	// the count is not trusted. runs are read a block at a time, so that
+	// a corrupt count fails at the end of the stream rather than asking
+	// for more memory than the stream holds.
+	constexpr uint32_t BLOCK = 4096;
+	unsigned char buf[2 * BLOCK];
+	for(uint32_t done = 0; done < num_runs;)
+	{
+		uint32_t n = std::min(BLOCK, num_runs - done);
+		if(!in.read(reinterpret_cast<char*>(buf), 2 * n))
+		{
+			clear();
+			return false;
+		}
+		for(uint32_t i = 0; i < n; i++)
+		{
+			auto word
+			    = static_cast<uint16_t>(buf[2 * i] | (buf[2 * i + 1] << 8));
+			uint32_t length = (uint32_t{word} >> DIR_BITS) + 1;
+			runs_.push_back(word);
+			steps_ += length;
+			advance_(static_cast<grid::direction_id>(word & DIR_MASK), length);
+		}
+		done += n;
+	}
+	return true;
+}
+
+} // namespace warthog::search
+
+std::ostream&
+operator<<(std::ostream& str, const warthog::search::compact_path& path)
+{
+	static constexpr const char* names[]
+	    = {"N", "S", "E", "W", "NE", "NW", "SE", "SW"};
+	str << "start=" << warthog::sn_id_t{path.start()} << " runs=";
+	for(size_t i = 0; i < path.num_runs(); i++)
+	{
+		auto r = path.get_run(i);
+		str << names[r.dir_] << r.length_ << " ";
+	}
+	return str;
+}
@@ -0,0 +1,161 @@
+#include <warthog/constants.h>
+#include <warthog/search/cost_predictor.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace warthog::search
+{
+
+namespace
+{
+
+// the terms of the model for the features @param f
+std::array<double, 4>
+terms(const query_features& f)
+{
+	return {
+	    1.0, std::log1p(f.octile_), f.density_,
+	    std::log((double)std::max(f.component_size_, 1u))};
+}
+
+} // namespace
+
+cost_predictor::cost_predictor(const domain::gridmap& map, uint32_t block)
+    : map_(&map), components_(map), block_(std::max(block, 1u))
+{
+	uint32_t width       = map.header_width();
+	uint32_t height      = map.header_height();
+	blocks_wide_         = (width + block_ - 1) / block_;
+	uint32_t blocks_high = (height + block_ - 1) / block_;
+
+	// blocks on the right and bottom edges may be partial
+	std::vector<uint32_t> blocked(blocks_wide_ * blocks_high, 0);
+	std::vector<uint32_t> cells(blocks_wide_ * blocks_high, 0);
+	for(uint32_t y = 0; y < height; y++)
+	{
+		for(uint32_t x = 0; x < width; x++)
+		{
+			uint32_t b = (y / block_) * blocks_wide_ + x / block_;
+			cells[b]++;
+			blocked[b] += !map.get_label(map.to_padded_id_from_unpadded(x, y));
+		}
+	}
+	density_.resize(cells.size());
+	for(size_t b = 0; b < cells.size(); b++)
+	{
+		density_[b] = (float)blocked[b] / cells[b];
+	}
+}
+
+query_features
+cost_predictor::features(
+    uint32_t sx, uint32_t sy, uint32_t gx, uint32_t gy) const
+{
+	query_features f;
+	double dx    = std::abs((double)gx - sx);
+	double dy    = std::abs((double)gy - sy);
+	f.octile_    = std::max(dx, dy) + (DBL_ROOT_TWO - 1) * std::min(dx, dy);
+	pad_id sid   = map_->to_padded_id_from_unpadded(sx, sy);
+	pad_id gid   = map_->to_padded_id_from_unpadded(gx, gy);
+	f.connected_ = components_.connected(sid, gid);
+	uint32_t c   = components_.get(sid);
+	f.component_size_
+	    = c == domain::grid_components::NONE ? 0 : components_.size(c);
+
+	// sample the line twice per block crossed
+	uint32_t samples = 1 + (uint32_t)(2 * std::max(dx, dy) / block_);
+	double sum       = 0;
+	for(uint32_t i = 0; i < samples; i++)
+	{
+		double t   = (i + 0.5) / samples;
+		uint32_t x = (uint32_t)(sx + t * ((double)gx - sx));
+		uint32_t y = (uint32_t)(sy + t * ((double)gy - sy));
+		sum += density_[(y / block_) * blocks_wide_ + x / block_];
+	}
+	f.density_ = sum / samples;
+	return f;
+}
+
+double
+cost_predictor::expansions(const query_features& f) const
+{
+	if(!f.connected_) { return f.component_size_; }
+	std::array<double, 4> x = terms(f);
+	double y                = 0;
+	for(size_t i = 0; i < x.size(); i++)
+	{
+		y += model_.w_[i] * x[i];
+	}
+	return std::expm1(y);
+}
+
+void
+cost_predictor::fit(
+    const std::vector<query_features>& f, const std::vector<double>& expanded,
+    const std::vector<double>& nanos)
+{
+	// least squares on the solvable queries, by the normal equations.
+	// a small ridge keeps them solvable when a feature does not vary,
+	// e.g. when every query is in the same component.
+	constexpr size_t N = 4;
+	double a[N][N + 1] = {};
+	double total_nanos = 0, total_expanded = 0;
+	uint32_t used = 0;
+	for(size_t q = 0; q < f.size(); q++)
+	{
+		total_nanos    += nanos[q];
+		total_expanded += expanded[q];
+		if(!f[q].connected_) { continue; }
+		std::array<double, N> x = terms(f[q]);
+		double y                = std::log1p(expanded[q]);
+		for(size_t i = 0; i < N; i++)
+		{
+			for(size_t j = 0; j < N; j++)
+			{
+				a[i][j] += x[i] * x[j];
+			}
+			a[i][N] += x[i] * y;
+		}
+		used++;
+	}
+	if(used < 2 * N) { return; }
+
+	// gaussian elimination with partial pivoting
+	for(size_t i = 0; i < N; i++)
+	{
+		a[i][i] += 1e-6 * used;
+	}
+	for(size_t i = 0; i < N; i++)
+	{
+		size_t p = i;
+		for(size_t r = i + 1; r < N; r++)
+		{
+			if(std::abs(a[r][i]) > std::abs(a[p][i])) { p = r; }
+		}
+		std::swap(a[i], a[p]);
+		for(size_t r = i + 1; r < N; r++)
+		{
+			double m = a[r][i] / a[i][i];
+			for(size_t c = i; c <= N; c++)
+			{
+				a[r][c] -= m * a[i][c];
+			}
+		}
+	}
+	for(size_t i = N; i-- > 0;)
+	{
+		double y = a[i][N];
+		for(size_t c = i + 1; c < N; c++)
+		{
+			y -= a[i][c] * model_.w_[c];
+		}
+		model_.w_[i] = y / a[i][i];
+	}
+	if(total_expanded > 0)
+	{
+		model_.nanos_per_expansion_ = total_nanos / total_expanded;
+	}
+}
+
+} // namespace warthog::search
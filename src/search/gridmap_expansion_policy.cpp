@@ -1,6 +1,10 @@
 #include <warthog/search/gridmap_expansion_policy.h>
 #include <warthog/search/problem_instance.h>
 #include <warthog/util/helpers.h>
+#include <warthog/util/prefetch.h>
+
+#include <array>
+#include <bit>
 
 namespace warthog::search
 {
@@ -80,88 +84,112 @@ gridmap_expansion_policy_base::mem()
 	    + map_->mem();
 }
 
+namespace
+{
+
+// successor sets for each of the 256 packed neighbourhoods
+constexpr std::array<uint8_t, 256> MOVE_TABLE = []() {
+	std::array<uint8_t, 256> table{};
+	for(uint32_t i = 0; i < 256; i++)
+	{
+		table[i] = grid::legal_moves(static_cast<uint8_t>(i));
+	}
+	return table;
+}();
+
+// move costs, by direction_id; cardinal moves come first
+constexpr cost_t ROOT_TWO = static_cast<cost_t>(warthog::DBL_ROOT_TWO);
+constexpr std::array<cost_t, 8> MOVE_COST
+    = {1, 1, 1, 1, ROOT_TWO, ROOT_TWO, ROOT_TWO, ROOT_TWO};
+
+static_assert(
+    grid::NORTH_ID < 4 && grid::SOUTH_ID < 4 && grid::EAST_ID < 4
+    && grid::WEST_ID < 4);
+
+} // namespace
+
 gridmap_expansion_policy::gridmap_expansion_policy(
-    domain::gridmap* map, bool manhattan)
-    : gridmap_expansion_policy_base(map), manhattan_(manhattan)
-{ }
+    domain::gridmap* map, bool manhattan, const domain::move_table* moves)
+    : gridmap_expansion_policy_base(map), manhattan_(manhattan),
+      move_mask_(manhattan ? 0x0f : 0xff), moves_(moves)
+{
+	for(uint32_t d = 0; d < 8; d++)
+	{
+		auto dir    = static_cast<grid::direction_id>(d);
+		offsets_[d] = grid::dir_id_dx(dir)
+		    + grid::dir_id_dy(dir) * static_cast<int32_t>(map_->width());
+	}
+}
 
 void
 gridmap_expansion_policy::expand(
     search_node* current, search_problem_instance* problem)
 {
 	reset();
-
-	// get terrain type of each tile in the 3x3 square around (x, y)
-	uint32_t tiles = 0;
 	pad_id nodeid  = current->get_id();
-	map_->get_neighbours(nodeid, (uint8_t*)&tiles);
-
-	//	#ifndef NDEBUG
-	//	uint32_t cx_, cy_;
-	//	warthog::helpers::index_to_xy(nodeid, map_->width(), cx_, cy_);
-	//	assert(tiles[0] == map_->get_label(cx_-1, cy_-1));
-	//	assert(tiles[1] == map_->get_label(cx_, cy_-1));
-	//	assert(tiles[2] == map_->get_label(cx_+1, cy_-1));
-	//	assert(tiles[3] == map_->get_label(cx_-1, cy_));
-	//	assert(tiles[4] == map_->get_label(cx_, cy_));
-	//	assert(tiles[5] == map_->get_label(cx_+1, cy_));
-	//	assert(tiles[6] == map_->get_label(cx_-1, cy_+1));
-	//	assert(tiles[7] == map_->get_label(cx_, cy_+1));
-	//	assert(tiles[8] == map_->get_label(cx_+1, cy_+1));
-	//	#endif
-
-	// NB: no corner cutting or squeezing between obstacles!
-	pad_id nid_m_w = pad_id{nodeid.id - map_->width()};
-	pad_id nid_p_w = pad_id{nodeid.id + map_->width()};
-
-	// generate cardinal moves
-	if((tiles & 514) == 514) // N
-	{
-		add_neighbour(this->generate(nid_m_w), 1);
-	}
-	if((tiles & 1536) == 1536) // E
-	{
-		add_neighbour(this->generate(pad_id{nodeid.id + 1}), 1);
-	}
-	if((tiles & 131584) == 131584) // S
+	uint32_t moves = legal_moves_(nodeid);
+	if constexpr(util::PREFETCH_HINTS)
 	{
-		add_neighbour(this->generate(nid_p_w), 1);
+		// start fetching every successor before generating the first
+		for(uint32_t m = moves; m; m &= m - 1)
+		{
+			expansion_policy::prefetch(
+			    pad_id{nodeid.id + offsets_[std::countr_zero(m)]});
+		}
 	}
-	if((tiles & 768) == 768) // W
-	{
-		add_neighbour(this->generate(pad_id{nodeid.id - 1}), 1);
-	}
-	if(manhattan_) { return; }
-
-	// generate diagonal moves
-	if((tiles & 1542) == 1542) // NE
-	{
-		add_neighbour(
-		    this->generate(pad_id{nid_m_w.id + 1}), warthog::DBL_ROOT_TWO);
-	}
-	if((tiles & 394752) == 394752) // SE
+	while(moves)
 	{
+		uint32_t d = std::countr_zero(moves);
+		moves     &= moves - 1;
 		add_neighbour(
-		    this->generate(pad_id{nid_p_w.id + 1}), warthog::DBL_ROOT_TWO);
+		    this->generate(pad_id{nodeid.id + offsets_[d]}), MOVE_COST[d]);
 	}
-	if((tiles & 197376) == 197376) // SW
+}
+
+uint32_t
+gridmap_expansion_policy::successors(
+    pad_id node_id, pad_id* ids, cost_t* costs)
+{
+	uint32_t num = 0;
+	for(uint32_t moves = legal_moves_(node_id); moves; moves &= moves - 1)
 	{
-		add_neighbour(
-		    this->generate(pad_id{nid_p_w.id - 1}), warthog::DBL_ROOT_TWO);
+		uint32_t d = std::countr_zero(moves);
+		ids[num]   = pad_id{node_id.id + offsets_[d]};
+		costs[num] = MOVE_COST[d];
+		num++;
 	}
-	if((tiles & 771) == 771) // NW
+	return num;
+}
+
+bool
+gridmap_expansion_policy::traversable(pad_id node_id)
+{
+	uint32_t max_id = map_->width() * map_->height();
+	return uint32_t{node_id} < max_id && map_->get_label(node_id) != 0;
+}
+
+uint32_t
+gridmap_expansion_policy::legal_moves_(pad_id node_id)
+{
+	// the legal moves come from a table; no corner cutting or squeezing
+	// between obstacles. successors are generated in direction_id order.
+	uint32_t moves;
+	if(moves_) { moves = moves_->get(node_id); }
+	else
 	{
-		add_neighbour(
-		    this->generate(pad_id{nid_m_w.id - 1}), warthog::DBL_ROOT_TWO);
+		// get terrain type of each tile in the 3x3 square around (x, y)
+		// NB: 4 bytes, as pack_neighbours may read one past the 3 rows
+		uint32_t tiles = 0;
+		map_->get_neighbours(node_id, (uint8_t*)&tiles);
+		moves = MOVE_TABLE[domain::gridmap::pack_neighbours((uint8_t*)&tiles)];
 	}
+	return moves & move_mask_;
 }
 
 search_node*
 gridmap_expansion_policy::generate_start_node(search_problem_instance* pi)
 {
-	uint32_t max_id = map_->width() * map_->height();
-	if(uint32_t{pi->start_} >= max_id) { return 0; }
-	if(map_->get_label(pi->start_) == 0) { return 0; }
+	if(!traversable(pi->start_)) { return 0; }
 	return generate(pi->start_);
 }
 
@@ -179,7 +207,8 @@ gridmap_expansion_policy::mem()
 {
 	return gridmap_expansion_policy_base::mem()
 	    + (sizeof(gridmap_expansion_policy)
-	       - sizeof(gridmap_expansion_policy_base));
+	       - sizeof(gridmap_expansion_policy_base))
+	    + (moves_ ? moves_->mem() : 0);
 }
 
 } // warthog::expansion_policy
@@ -7,6 +7,7 @@ operator<<(std::ostream& str, const warthog::search::search_metrics& met)
 	    << " nodes expanded=" << met.nodes_expanded_
 	    << " touched=" << met.nodes_generated_
 	    << " reopened=" << met.nodes_reopen_
+	    << " pruned=" << met.nodes_pruned_
 	    << " surplus=" << met.nodes_surplus_ << " heap-ops=" << met.heap_ops_
 	    << " lb=" << met.lb_ << " ub=" << met.ub_;
 	return str;
@@ -0,0 +1,77 @@
+#include <warthog/util/locality_order.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace warthog::util
+{
+
+namespace
+{
+
+// spread the 32 bits of @param v over the even bits of the result
+uint64_t
+spread(uint32_t v) noexcept
+{
+	uint64_t x = v;
+	x          = (x | (x << 16)) & 0x0000ffff0000ffffull;
+	x          = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+	x          = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+	x          = (x | (x << 2)) & 0x3333333333333333ull;
+	x          = (x | (x << 1)) & 0x5555555555555555ull;
+	return x;
+}
+
+} // namespace
+
+uint32_t
+hilbert_index(uint32_t x, uint32_t y) noexcept
+{
+	// descend the curve a quadrant at a time, rotating the remaining
+	// coordinates into the frame of the quadrant
+	uint32_t d = 0;
+	x &= 0xffff;
+	y &= 0xffff;
+	for(uint32_t s = 1u << 15; s > 0; s >>= 1)
+	{
+		uint32_t rx = (x & s) ? 1 : 0;
+		uint32_t ry = (y & s) ? 1 : 0;
+		d += s * s * ((3 * rx) ^ ry);
+		if(ry == 0)
+		{
+			if(rx == 1)
+			{
+				x = s - 1 - (x & (s - 1));
+				y = s - 1 - (y & (s - 1));
+			}
+			std::swap(x, y);
+		}
+		x &= s - 1;
+		y &= s - 1;
+	}
+	return d;
+}
+
+uint64_t
+locality_key(uint32_t sx, uint32_t sy, uint32_t gx, uint32_t gy) noexcept
+{
+	return (spread(hilbert_index(sx, sy)) << 1)
+	    | spread(hilbert_index(gx, gy));
+}
+
+void
+locality_order(
+    std::vector<uint32_t>& order, const std::vector<uint64_t>& keys,
+    uint32_t window)
+{
+	if(window == 0) { window = (uint32_t)order.size(); }
+	auto by_key = [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; };
+	for(size_t first = 0; first < order.size(); first += window)
+	{
+		size_t last = std::min(order.size(), first + window);
+		std::stable_sort(
+		    order.begin() + first, order.begin() + last, by_key);
+	}
+}
+
+} // namespace warthog::util
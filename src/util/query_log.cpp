@@ -0,0 +1,164 @@
+#include <warthog/util/query_log.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace warthog::util
+{
+
+namespace
+{
+
+constexpr char MAGIC[8]      = {'W', 'Q', 'L', 'O', 'G', '0', '0', '1'};
+constexpr uint32_t TAG_MAP   = 1;
+constexpr uint32_t TAG_QUERY = 2;
+
+template<typename T>
+void
+put(std::ofstream& out, const T& value)
+{
+	out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+bool
+get(std::ifstream& in, T& value)
+{
+	return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+query_log_writer::query_log_writer(const char* filename)
+    : out_(filename, std::ios::binary | std::ios::trunc),
+      opened_(std::chrono::steady_clock::now()), flushed_(opened_),
+      queries_(0)
+{
+	if(!out_)
+	{
+		throw std::runtime_error(
+		    std::string("cannot write query log ") + filename);
+	}
+	out_.write(MAGIC, sizeof(MAGIC));
+}
+
+uint32_t
+query_log_writer::add_map(
+    const std::string& name, uint32_t width, uint32_t height)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto [it, added] = maps_.try_emplace(name, (uint32_t)maps_.size());
+	if(added)
+	{
+		put(out_, TAG_MAP);
+		put(out_, width);
+		put(out_, height);
+		put(out_, (uint32_t)name.size());
+		out_.write(name.data(), name.size());
+	}
+	return it->second;
+}
+
+void
+query_log_writer::write(const query_record& r)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	put(out_, TAG_QUERY);
+	put(out_, r);
+	queries_++;
+
+	// a long-running process may be stopped at any time; keep what has
+	// been recorded on disk, but without a write for every query
+	auto now = std::chrono::steady_clock::now();
+	if(now - flushed_ > std::chrono::milliseconds(100))
+	{
+		out_.flush();
+		flushed_ = now;
+	}
+}
+
+uint64_t
+query_log_writer::now() const
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	           std::chrono::steady_clock::now() - opened_)
+	    .count();
+}
+
+uint64_t
+query_log_writer::num_queries() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return queries_;
+}
+
+void
+query_log_writer::flush()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	out_.flush();
+}
+
+query_log_reader::query_log_reader(const char* filename)
+    : in_(filename, std::ios::binary)
+{
+	char magic[sizeof(MAGIC)];
+	if(!in_ || !in_.read(magic, sizeof(magic))
+	   || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		throw std::runtime_error(
+		    std::string("not a query log: ") + filename);
+	}
+}
+
+bool
+query_log_reader::next(query_record& r)
+{
+	uint32_t tag;
+	while(true)
+	{
+		if(!get(in_, tag))
+		{
+			if(in_.gcount() == 0) { return false; } // the end of the log
+			break;
+		}
+		if(tag == TAG_QUERY)
+		{
+			if(!get(in_, r) || r.map_ >= maps_.size()) { break; }
+			return true;
+		}
+		query_log_map m;
+		uint32_t length;
+		if(tag != TAG_MAP || !get(in_, m.width_) || !get(in_, m.height_)
+		   || !get(in_, length) || length > 4096)
+		{
+			break;
+		}
+		m.name_.resize(length);
+		if(!in_.read(m.name_.data(), length)) { break; }
+		maps_.push_back(std::move(m));
+	}
+	throw std::runtime_error("corrupt query log");
+}
+
+void
+query_recorder::record(
+    const search::problem_instance& pi, const search::search_parameters& par,
+    const search::solution& sol)
+{
+	query_record r;
+	r.nanos_      = sol.met_.time_elapsed_nano_.count();
+	uint64_t now  = log_->now();
+	r.time_       = now > r.nanos_ ? now - r.nanos_ : 0;
+	r.map_        = map_;
+	r.start_      = pi.start_.id;
+	r.target_     = pi.target_.id;
+	r.exp_cutoff_ = par.get_max_expansions_cutoff();
+	r.weight_     = par.get_w_admissibility();
+	r.cost_       = sol.sum_of_edge_costs_;
+	r.expanded_   = sol.met_.nodes_expanded_;
+	r.generated_  = sol.met_.nodes_generated_;
+	log_->write(r);
+}
+
+} // namespace warthog::util
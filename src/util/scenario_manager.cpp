@@ -1,9 +1,16 @@
+#include <warthog/domain/grid_components.h>
 #include <warthog/search/dummy_listener.h>
 #include <warthog/search/problem_instance.h>
 #include <warthog/util/scenario_manager.h>
+#include <warthog/util/scenario_reader.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace warthog::util
 {
@@ -22,59 +29,65 @@ scenario_manager::~scenario_manager()
 void
 scenario_manager::load_scenario(const char* filelocation)
 {
-	std::ifstream infile;
-	infile.open(filelocation, std::ios::in);
-
-	if(!infile.good())
+	try
 	{
-		std::cerr << "err; scenario_manager::load_scenario "
-		          << "Invalid scenario file: " << filelocation << std::endl;
-		infile.close();
-		exit(1);
+		scenario_reader reader(filelocation);
+		sfile_ = filelocation;
+		load_gppc_scenario(reader);
 	}
-
-	sfile_ = filelocation;
-
-	char buf[1024];
-	infile.getline(buf, 1024);
-	if(strstr(buf, "version 1"))
+	catch(const std::runtime_error& e)
 	{
-		// GPPC format scenarios
-		load_gppc_scenario(infile);
-	}
-	else
-	{
-		std::cerr << "err; scenario_manager::load_scenario "
-		          << " scenario file not in GPPC format\n";
-		infile.close();
+		std::cerr << "err; scenario_manager::load_scenario " << e.what()
+		          << std::endl;
 		exit(1);
 	}
-	infile.close();
 }
 
 // V1.0 is the version officially supported by HOG
 void
-scenario_manager::load_gppc_scenario(std::ifstream& infile)
+scenario_manager::load_gppc_scenario(scenario_reader& reader)
 {
-	uint32_t sizeX = 0, sizeY = 0;
-	uint32_t bucket;
-	std::string map;
-	uint32_t xs, ys, xg, yg;
-	std::string dist;
-
-	while(infile >> bucket >> map >> sizeX >> sizeY >> xs >> ys >> xg >> yg
-	      >> dist)
+	experiments_.reserve(experiments_.size() + reader.size() / 32);
+	scenario_reader::query q;
+	while(reader.next(q))
 	{
-		double dbl_dist = strtod(dist.c_str(), 0);
-		experiments_.push_back(
-		    new experiment(xs, ys, xg, yg, sizeX, sizeY, dbl_dist, map));
+		experiments_.push_back(new experiment(
+		    q.startx_, q.starty_, q.goalx_, q.goaly_, q.mapwidth_,
+		    q.mapheight_, q.distance_, std::string(q.map_)));
+		experiments_.back()->set_precision(q.precision_);
+	}
+}
 
-		int32_t precision = 0;
-		if(dist.find(".") != std::string::npos)
-		{
-			precision = ((int32_t)dist.size() - (int32_t)(dist.find(".") + 1));
-		}
-		experiments_.back()->set_precision(precision);
+void
+scenario_manager::generate_experiments(
+    domain::gridmap* map, int num, uint32_t seed)
+{
+	domain::grid_components components(*map);
+	std::vector<pad_id> cells;
+	for(uint32_t id = 0; id < map->padded_mapsize(); id++)
+	{
+		if(map->get_label(pad_id{id})) { cells.push_back(pad_id{id}); }
+	}
+	if(cells.size() < 2) { return; }
+
+	// most pairs are connected on most maps; give up on maps where
+	// almost none are
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<size_t> pick(0, cells.size() - 1);
+	uint64_t attempts = 100 * (uint64_t)num;
+	for(int added = 0; added < num && attempts; attempts--)
+	{
+		pad_id start = cells[pick(rng)];
+		pad_id goal  = cells[pick(rng)];
+		if(start == goal || !components.connected(start, goal)) { continue; }
+
+		uint32_t sx, sy, gx, gy;
+		map->to_unpadded_xy(start, sx, sy);
+		map->to_unpadded_xy(goal, gx, gy);
+		experiments_.push_back(new experiment(
+		    sx, sy, gx, gy, map->header_width(), map->header_height(), 0,
+		    map->filename()));
+		added++;
 	}
 }
 
@@ -103,18 +116,63 @@ scenario_manager::write_scenario(std::ostream& scenariofile)
 void
 scenario_manager::sort()
 {
-	for(unsigned int i = 0; i < experiments_.size(); i++)
+	std::stable_sort(
+	    experiments_.begin(), experiments_.end(),
+	    [](const experiment* a, const experiment* b) {
+		    return a->distance() < b->distance();
+	    });
+}
+
+std::vector<std::unique_ptr<scenario_manager>>
+scenario_manager::split_by_map(std::vector<std::vector<uint32_t>>* index)
+{
+	std::vector<std::unique_ptr<scenario_manager>> groups;
+	std::unordered_map<std::string, uint32_t> group_of;
+	if(index) { index->clear(); }
+	for(uint32_t i = 0; i < experiments_.size(); i++)
+	{
+		auto [it, added] = group_of.try_emplace(
+		    experiments_[i]->map(), (uint32_t)groups.size());
+		if(added)
+		{
+			groups.push_back(std::make_unique<scenario_manager>());
+			groups.back()->sfile_ = sfile_;
+			if(index) { index->emplace_back(); }
+		}
+		groups[it->second]->add_experiment(experiments_[i]);
+		if(index) { (*index)[it->second].push_back(i); }
+	}
+	experiments_.clear();
+	return groups;
+}
+
+std::vector<std::unique_ptr<scenario_manager>>
+scenario_manager::split_by_size(uint32_t size)
+{
+	assert(size > 0);
+	std::vector<std::unique_ptr<scenario_manager>> groups;
+	for(uint32_t i = 0; i < experiments_.size(); i++)
 	{
-		for(unsigned int j = i; j < experiments_.size(); j++)
+		if(i % size == 0)
 		{
-			if(experiments_.at(j)->distance() < experiments_.at(i)->distance())
-			{
-				experiment* tmp    = experiments_.at(i);
-				experiments_.at(i) = experiments_.at(j);
-				experiments_.at(j) = tmp;
-			}
+			groups.push_back(std::make_unique<scenario_manager>());
+			groups.back()->sfile_ = sfile_;
 		}
+		groups.back()->add_experiment(experiments_[i]);
+	}
+	experiments_.clear();
+	return groups;
+}
+
+uint32_t
+scenario_manager::num_maps() const
+{
+	std::unordered_set<std::string> maps;
+	for(experiment* exp : experiments_)
+	{
+		maps.insert(exp->map());
 	}
+	return (uint32_t)maps.size();
 }
 
 /**
@@ -128,10 +186,11 @@ scenario_manager::sort()
  */
 std::filesystem::path
 find_map_filename(
-    const scenario_manager& scenmgr, std::filesystem::path sfilename)
+    const scenario_manager& scenmgr, std::filesystem::path sfilename,
+    uint32_t which)
 {
 	namespace fs        = std::filesystem;
-	const auto& mapname = scenmgr.get_experiment(0)->map();
+	const auto& mapname = scenmgr.get_experiment(which)->map();
 	// scen file has a map name designated.
 	if(!mapname.empty())
 	{
@@ -0,0 +1,142 @@
+#include <warthog/util/scenario_reader.h>
+
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace warthog::util
+{
+
+namespace
+{
+
+// a field of a line: the characters from pos up to the next space, tab
+// or end of line
+std::string_view
+field(const char*& pos, const char* end)
+{
+	while(pos < end && (*pos == ' ' || *pos == '\t'))
+	{
+		pos++;
+	}
+	const char* first = pos;
+	while(pos < end && *pos != ' ' && *pos != '\t')
+	{
+		pos++;
+	}
+	return {first, (size_t)(pos - first)};
+}
+
+template<typename T>
+bool
+number(std::string_view f, T& value)
+{
+	auto [ptr, ec] = std::from_chars(f.data(), f.data() + f.size(), value);
+	return ec == std::errc() && ptr == f.data() + f.size();
+}
+
+} // namespace
+
+scenario_reader::scenario_reader(const char* filename)
+    : data_(nullptr), size_(0), pos_(nullptr), line_(1)
+{
+	int fd = open(filename, O_RDONLY);
+	struct stat st;
+	if(fd < 0 || fstat(fd, &st) != 0)
+	{
+		if(fd >= 0) { close(fd); }
+		throw std::runtime_error(
+		    std::string("cannot read scenario file ") + filename);
+	}
+	size_ = (size_t)st.st_size;
+	if(size_ > 0)
+	{
+		int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+		flags |= MAP_POPULATE; // read ahead in one go
+#endif
+		void* data = mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+		if(data == MAP_FAILED)
+		{
+			close(fd);
+			throw std::runtime_error(
+			    std::string("cannot read scenario file ") + filename);
+		}
+		madvise(data, size_, MADV_SEQUENTIAL);
+		data_ = static_cast<const char*>(data);
+	}
+	close(fd); // the mapping stays valid
+	pos_ = data_;
+
+	std::string_view first(data_, size_);
+	first = first.substr(0, first.find('\n'));
+	if(first.find("version 1") == std::string_view::npos)
+	{
+		if(data_) { munmap(const_cast<char*>(data_), size_); }
+		throw std::runtime_error(
+		    std::string("scenario file not in GPPC format: ") + filename);
+	}
+	pos_ += first.size();
+}
+
+scenario_reader::~scenario_reader()
+{
+	if(data_) { munmap(const_cast<char*>(data_), size_); }
+}
+
+bool
+scenario_reader::next(query& q)
+{
+	const char* end = data_ + size_;
+	while(pos_ < end)
+	{
+		// pos_ is at the newline ending the previous line
+		if(*pos_ == '\n')
+		{
+			pos_++;
+			line_++;
+		}
+		auto* eol = static_cast<const char*>(
+		    std::memchr(pos_, '\n', (size_t)(end - pos_)));
+		if(!eol) { eol = end; }
+		const char* last = eol;
+		if(last > pos_ && last[-1] == '\r') { last--; }
+
+		const char* cur    = pos_;
+		std::string_view f = field(cur, last);
+		pos_               = eol;
+		if(f.empty()) { continue; } // blank line
+
+		std::string_view dist;
+		bool ok = number(f, q.bucket_);
+		q.map_  = field(cur, last);
+		ok      = ok && !q.map_.empty();
+		ok      = ok && number(field(cur, last), q.mapwidth_);
+		ok      = ok && number(field(cur, last), q.mapheight_);
+		ok      = ok && number(field(cur, last), q.startx_);
+		ok      = ok && number(field(cur, last), q.starty_);
+		ok      = ok && number(field(cur, last), q.goalx_);
+		ok      = ok && number(field(cur, last), q.goaly_);
+		dist    = field(cur, last);
+		ok      = ok && number(dist, q.distance_);
+		ok      = ok && field(cur, last).empty();
+		if(!ok)
+		{
+			throw std::runtime_error(
+			    "malformed scenario line " + std::to_string(line_));
+		}
+		size_t point = dist.find('.');
+		q.precision_ = point == std::string_view::npos
+		    ? 0
+		    : (int32_t)(dist.size() - point - 1);
+		return true;
+	}
+	return false;
+}
+
+} // namespace warthog::util
@@ -0,0 +1,142 @@
+#include <warthog/util/scenario_reader.h>
+#include <warthog/util/scenario_store.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace warthog::util
+{
+
+namespace
+{
+
+// reorder @param v so that element i is the old element order[i]
+template<typename T>
+void
+permute(std::vector<T>& v, const std::vector<uint32_t>& order)
+{
+	std::vector<T> out(v.size());
+	for(uint32_t i = 0; i < order.size(); i++)
+	{
+		out[i] = v[order[i]];
+	}
+	v.swap(out);
+}
+
+} // namespace
+
+void
+scenario_store::load(const char* filename)
+{
+	scenario_reader reader(filename);
+	// a query line is rarely shorter than 32 bytes
+	size_t expected = size() + reader.size() / 32;
+	startx_.reserve(expected);
+	starty_.reserve(expected);
+	goalx_.reserve(expected);
+	goaly_.reserve(expected);
+	distance_.reserve(expected);
+	precision_.reserve(expected);
+	map_.reserve(expected);
+
+	scenario_reader::query q;
+	while(reader.next(q))
+	{
+		add(q.startx_, q.starty_, q.goalx_, q.goaly_, q.distance_,
+		    q.precision_, q.map_, q.mapwidth_, q.mapheight_);
+	}
+}
+
+void
+scenario_store::add(
+    uint32_t sx, uint32_t sy, uint32_t gx, uint32_t gy, double distance,
+    int32_t precision, std::string_view map, uint32_t mapwidth,
+    uint32_t mapheight)
+{
+	startx_.push_back(sx);
+	starty_.push_back(sy);
+	goalx_.push_back(gx);
+	goaly_.push_back(gy);
+	distance_.push_back(distance);
+	precision_.push_back((int8_t)std::clamp(precision, 0, 127));
+	map_.push_back(intern_(map, mapwidth, mapheight));
+}
+
+uint32_t
+scenario_store::intern_(std::string_view name, uint32_t width, uint32_t height)
+{
+	auto same = [&](const map_entry& m) {
+		return m.width_ == width && m.height_ == height && m.name_ == name;
+	};
+	// scenario files list the queries of a map together
+	if(last_ != NONE && same(maps_[last_])) { return last_; }
+
+	auto [it, added] = by_name_.try_emplace(std::string(name), NONE);
+	uint32_t* link   = &it->second;
+	for(; *link != NONE; link = &maps_[*link].next_)
+	{
+		if(same(maps_[*link])) { return last_ = *link; }
+	}
+	*link = (uint32_t)maps_.size();
+	maps_.push_back({std::string(name), width, height, NONE});
+	return last_ = *link;
+}
+
+void
+scenario_store::sort()
+{
+	// sort keys with their positions, rather than positions alone, so
+	// the comparisons do not jump around distance_
+	std::vector<std::pair<double, uint32_t>> keys(size());
+	for(uint32_t i = 0; i < size(); i++)
+	{
+		keys[i] = {distance_[i], i};
+	}
+	std::stable_sort(keys.begin(), keys.end(), [](auto& a, auto& b) {
+		return a.first < b.first;
+	});
+	std::vector<uint32_t> order(size());
+	for(uint32_t i = 0; i < size(); i++)
+	{
+		order[i] = keys[i].second;
+	}
+	permute(startx_, order);
+	permute(starty_, order);
+	permute(goalx_, order);
+	permute(goaly_, order);
+	permute(distance_, order);
+	permute(precision_, order);
+	permute(map_, order);
+}
+
+void
+scenario_store::clear()
+{
+	startx_.clear();
+	starty_.clear();
+	goalx_.clear();
+	goaly_.clear();
+	distance_.clear();
+	precision_.clear();
+	map_.clear();
+	maps_.clear();
+	by_name_.clear();
+	last_ = NONE;
+}
+
+size_t
+scenario_store::mem() const noexcept
+{
+	size_t bytes = sizeof(*this)
+	    + startx_.capacity() * 4 * sizeof(uint32_t)
+	    + distance_.capacity() * sizeof(double)
+	    + precision_.capacity() * sizeof(int8_t)
+	    + map_.capacity() * sizeof(uint32_t);
+	for(const map_entry& m : maps_)
+	{
+		bytes += sizeof(map_entry) + 2 * m.name_.capacity();
+	}
+	return bytes;
+}
+
+} // namespace warthog::util
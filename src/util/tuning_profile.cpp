@@ -0,0 +1,136 @@
+#include <warthog/util/tuning_profile.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace warthog::util
+{
+
+std::string
+tuning_profile::name() const
+{
+	std::string ans = queue_;
+	if(queue_ != "binary") { ans += "-" + tiebreak_; }
+	ans += lazy_h_ ? "-lazy" : "-eager";
+	if(movetable_) { ans += "-movetable"; }
+	return ans;
+}
+
+bool
+tuning_profile::matches(const domain::gridmap& map) const
+{
+	return stats_.width_ == map.header_width()
+	    && stats_.height_ == map.header_height()
+	    && stats_.traversable_ == map.get_num_traversable_tiles();
+}
+
+bool
+tuning_profile::load(const char* filename)
+{
+	std::ifstream file(filename);
+	if(!file.is_open())
+	{
+		std::cerr << "err; tuning_profile::load "
+		             "cannot open profile: "
+		          << filename << std::endl;
+		return false;
+	}
+
+	tuning_profile prof;
+	std::string line;
+	uint32_t lineno = 0;
+	while(std::getline(file, line))
+	{
+		lineno++;
+		std::istringstream in(line);
+		std::string key, value;
+		if(!(in >> key) || key[0] == '#') { continue; }
+		std::getline(in >> std::ws, value);
+		value.erase(value.find_last_not_of(" \t\r") + 1);
+
+		bool ok = !value.empty();
+		if(key == "queue")
+		{
+			prof.queue_ = value;
+			ok          = ok
+			    && (value == "binary" || value == "packed" || value == "lazy");
+		}
+		else if(key == "tiebreak")
+		{
+			prof.tiebreak_ = value;
+			ok = ok
+			    && (value == "g" || value == "h" || value == "lifo"
+			        || value == "fifo");
+		}
+		else if(key == "heuristic")
+		{
+			prof.lazy_h_ = value == "lazy";
+			ok           = ok && (value == "lazy" || value == "eager");
+		}
+		else if(key == "movetable")
+		{
+			prof.movetable_ = value == "1";
+			ok              = ok && (value == "0" || value == "1");
+		}
+		else
+		{
+			std::istringstream num(value);
+			domain::map_stats& s = prof.stats_;
+			if(key == "width") { num >> s.width_; }
+			else if(key == "height") { num >> s.height_; }
+			else if(key == "traversable") { num >> s.traversable_; }
+			else if(key == "components") { num >> s.components_; }
+			else if(key == "obstacle_density") { num >> s.obstacle_density_; }
+			else if(key == "largest_share") { num >> s.largest_share_; }
+			else if(key == "corridor_ratio") { num >> s.corridor_ratio_; }
+			else if(key == "cost_model")
+			{
+				search::cost_model& m = prof.model_;
+				num >> m.w_[0] >> m.w_[1] >> m.w_[2] >> m.w_[3]
+				    >> m.nanos_per_expansion_;
+			}
+			else { num.setstate(std::ios::failbit); }
+			ok = ok && !num.fail();
+		}
+
+		if(!ok)
+		{
+			std::cerr << "err; tuning_profile::load "
+			             "invalid entry at line "
+			          << lineno << " of " << filename << ": " << line
+			          << std::endl;
+			return false;
+		}
+	}
+	*this = prof;
+	return true;
+}
+
+void
+tuning_profile::save(std::ostream& out) const
+{
+	out << "queue " << queue_ << "\n"
+	    << "tiebreak " << tiebreak_ << "\n"
+	    << "heuristic " << (lazy_h_ ? "lazy" : "eager") << "\n"
+	    << "movetable " << (movetable_ ? 1 : 0) << "\n"
+	    << "width " << stats_.width_ << "\n"
+	    << "height " << stats_.height_ << "\n"
+	    << "traversable " << stats_.traversable_ << "\n"
+	    << "components " << stats_.components_ << "\n"
+	    << "obstacle_density " << stats_.obstacle_density_ << "\n"
+	    << "largest_share " << stats_.largest_share_ << "\n"
+	    << "corridor_ratio " << stats_.corridor_ratio_ << "\n"
+	    << "cost_model " << model_.w_[0] << " " << model_.w_[1] << " "
+	    << model_.w_[2] << " " << model_.w_[3] << " "
+	    << model_.nanos_per_expansion_ << "\n";
+}
+
+std::filesystem::path
+profile_filename(const std::filesystem::path& mapfile)
+{
+	std::filesystem::path ans = mapfile;
+	ans += ".profile";
+	return ans;
+}
+
+} // namespace warthog::util
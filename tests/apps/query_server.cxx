@@ -0,0 +1,195 @@
+#include "query_server.h"
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <warthog/constants.h>
+#include <warthog/domain/gridmap.h>
+
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+
+using warthog::util::query_frame;
+using warthog::util::query_server;
+using warthog::util::result_frame;
+
+// 16x16 open map, split by a wall at x = 8 with a gap at (8, 0)
+void
+walled_map(warthog::domain::gridmap& map)
+{
+	for(uint32_t y = 0; y < 16; y++)
+		for(uint32_t x = 0; x < 16; x++)
+			map.set_label(x, y, x != 8 || y == 0);
+}
+
+// serve @param input through a pair of pipes; the output written by
+// the time ::serve returns
+std::string
+serve(query_server& server, const std::string& input)
+{
+	int in[2], out[2];
+	REQUIRE(::pipe(in) == 0);
+	REQUIRE(::pipe(out) == 0);
+	ssize_t size = ::write(in[1], input.data(), input.size());
+	REQUIRE(size == (ssize_t)input.size());
+	::close(in[1]);
+
+	server.serve(in[0], out[1]);
+	::close(in[0]);
+	::close(out[1]);
+
+	std::string output;
+	char chunk[4096];
+	ssize_t n;
+	while((n = ::read(out[0], chunk, sizeof(chunk))) > 0)
+	{
+		output.append(chunk, n);
+	}
+	::close(out[0]);
+	return output;
+}
+
+// the lines of @param output, by their first word
+std::map<std::string, std::vector<std::string>>
+replies(const std::string& output)
+{
+	std::map<std::string, std::vector<std::string>> lines;
+	std::istringstream in(output);
+	std::string line;
+	while(std::getline(in, line))
+	{
+		std::istringstream words(line);
+		std::string id, word;
+		words >> id;
+		std::vector<std::string>& rest = lines[id];
+		while(words >> word)
+		{
+			rest.push_back(word);
+		}
+	}
+	return lines;
+}
+
+} // namespace
+
+TEST_CASE("query_server text framing", "[query_server]")
+{
+	warthog::domain::gridmap map(16, 16);
+	walled_map(map);
+	query_server server(map, nullptr, 2, false);
+
+	std::string output = serve(
+	    server,
+	    "# a comment, then a blank line\n"
+	    "\n"
+	    "1 0 0 0 3\n"
+	    "2 0 0 15 0\n"
+	    "3 0 0 99 0\n"
+	    "4 1 2\n"
+	    "x 1 2 3 4\n"
+	    "5 8 5 0 0");
+	auto lines = replies(output);
+
+	REQUIRE(lines.size() == 6);
+	REQUIRE(lines["1"].size() == 4);
+	REQUIRE(std::stod(lines["1"][0]) == Catch::Approx(3));
+	REQUIRE(lines["1"][1] == "3");
+	REQUIRE(std::stod(lines["2"][0]) == Catch::Approx(15));
+	REQUIRE(lines["3"] == std::vector<std::string>{"error"});
+	REQUIRE(lines["4"] == std::vector<std::string>{"error"});
+	REQUIRE(lines["-"] == std::vector<std::string>{"error"});
+	// the start is blocked
+	REQUIRE(lines["5"][0] == "-1");
+}
+
+TEST_CASE("query_server binary framing", "[query_server]")
+{
+	warthog::domain::gridmap map(16, 16);
+	walled_map(map);
+	query_server server(map, nullptr, 2, true);
+
+	std::vector<query_frame> queries{
+	    {1, 0, 0, 0, 3}, {2, 0, 5, 15, 5}, {3, 0, 0, 16, 0}, {4, 8, 5, 0, 0}};
+	std::string input(
+	    (const char*)queries.data(), queries.size() * sizeof(query_frame));
+	input.append(5, '\0'); // a partial frame is dropped
+	std::string output = serve(server, input);
+
+	REQUIRE(output.size() == queries.size() * sizeof(result_frame));
+	std::map<uint32_t, result_frame> results;
+	for(size_t i = 0; i < queries.size(); i++)
+	{
+		result_frame r;
+		std::memcpy(&r, output.data() + i * sizeof(r), sizeof(r));
+		results[r.id_] = r;
+	}
+	REQUIRE(results.size() == 4);
+	REQUIRE(results[1].status_ == result_frame::SOLVED);
+	REQUIRE(results[1].cost_ == Catch::Approx(3));
+	REQUIRE(results[1].plen_ == 3);
+	REQUIRE(results[2].status_ == result_frame::SOLVED);
+	REQUIRE(results[2].cost_ > 15);
+	REQUIRE(results[3].status_ == result_frame::INVALID);
+	REQUIRE(results[4].status_ == result_frame::NO_PATH);
+	REQUIRE(results[4].cost_ == -1);
+}
+
+TEST_CASE("query_server map updates", "[query_server]")
+{
+	warthog::domain::gridmap map(16, 16);
+	walled_map(map);
+	query_server server(map, nullptr, 2, false);
+
+	// closing the gap cuts the map in two. a query may run on a later
+	// version than the one it was sent after, so the map is opened again
+	// on a second connection, once the first has drained.
+	std::string closed = serve(server, "set 8 0 0\n1 0 5 15 5\n");
+	std::string opened = serve(
+	    server,
+	    "set 8 0 1 8 5 1\n"
+	    "2 0 5 15 5\n"
+	    "set 16 0 1\n"
+	    "set 8 0 2\n"
+	    "set \n");
+
+	auto before = replies(closed);
+	auto after  = replies(opened);
+	REQUIRE(before["1"][0] == "-1");
+	REQUIRE(std::stod(after["2"][0]) == Catch::Approx(15));
+
+	// each change is answered with the version that publishes it
+	REQUIRE(before["set"].size() == 1);
+	REQUIRE(after["set"].size() == 4);
+	uint64_t v1 = std::stoull(before["set"][0]);
+	uint64_t v2 = std::stoull(after["set"][0]);
+	REQUIRE(v1 < v2);
+	for(size_t i = 1; i < 4; i++)
+	{
+		REQUIRE(after["set"][i] == "error");
+	}
+}
+
+TEST_CASE("query_server drains before it returns", "[query_server]")
+{
+	warthog::domain::gridmap map(16, 16);
+	walled_map(map);
+	query_server server(map, nullptr, 4, false, 16);
+
+	std::ostringstream input;
+	for(uint32_t i = 0; i < 500; i++)
+	{
+		input << i << " " << i % 8 << " " << i % 16 << " 15 " << (i * 7) % 16
+		      << "\n";
+	}
+	auto lines = replies(serve(server, input.str()));
+	REQUIRE(lines.size() == 500);
+	for(uint32_t i = 0; i < 500; i++)
+	{
+		REQUIRE(lines[std::to_string(i)].size() == 4);
+	}
+}
@@ -0,0 +1,101 @@
+#include "shard_pool.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <csignal>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+
+// die as a crashing task does, bypassing the test framework's handler
+[[noreturn]] void
+crash()
+{
+	std::signal(SIGABRT, SIG_DFL);
+	std::abort();
+}
+
+// a task which writes its number
+int
+print_task(uint32_t task)
+{
+	std::cout << "task " << task << "\n";
+	return 0;
+}
+
+// the output of print_task for tasks 0 to @param num - 1, in order
+std::string
+printed(uint32_t num)
+{
+	std::ostringstream out;
+	for(uint32_t t = 0; t < num; t++)
+	{
+		out << "task " << t << "\n";
+	}
+	return out.str();
+}
+
+} // namespace
+
+TEST_CASE("shard_pool writes results in task order", "[shard_pool]")
+{
+	warthog::util::shard_pool pool(3);
+	std::ostringstream out;
+	REQUIRE(pool.run(20, print_task, out) == 0);
+	REQUIRE(out.str() == printed(20));
+	REQUIRE(pool.get_restarts() == 0);
+	REQUIRE(pool.get_failed() == 0);
+}
+
+TEST_CASE("shard_pool retries a task whose worker died", "[shard_pool]")
+{
+	// workers are separate processes; the first attempt leaves a file
+	// behind for the second to find
+	char dir[] = "/tmp/shard_pool_XXXXXX";
+	REQUIRE(::mkdtemp(dir) != nullptr);
+	std::string marker = std::string(dir) + "/attempted";
+
+	warthog::util::shard_pool pool(2, 3);
+	std::ostringstream out;
+	int ret = pool.run(
+	    10,
+	    [&](uint32_t task) {
+		    if(task == 4 && ::access(marker.c_str(), F_OK) != 0)
+		    {
+			    ::close(::open(marker.c_str(), O_CREAT | O_WRONLY, 0600));
+			    crash();
+		    }
+		    return print_task(task);
+	    },
+	    out);
+	::unlink(marker.c_str());
+	::rmdir(dir);
+
+	REQUIRE(ret == 0);
+	REQUIRE(out.str() == printed(10));
+	REQUIRE(pool.get_restarts() == 1);
+	REQUIRE(pool.get_failed() == 0);
+}
+
+TEST_CASE("shard_pool gives up on a task that always crashes", "[shard_pool]")
+{
+	warthog::util::shard_pool pool(2, 3);
+	std::ostringstream out;
+	int ret = pool.run(
+	    6,
+	    [](uint32_t task) {
+		    if(task == 2) { crash(); }
+		    return print_task(task);
+	    },
+	    out);
+
+	REQUIRE(ret != 0);
+	REQUIRE(pool.get_restarts() == 3);
+	REQUIRE(pool.get_failed() == 1);
+	// the other tasks are still written, in order
+	REQUIRE(out.str() == "task 0\ntask 1\ntask 3\ntask 4\ntask 5\n");
+}
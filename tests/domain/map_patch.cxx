@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <warthog/domain/grid_components.h>
+#include <warthog/domain/gridmap.h>
+#include <warthog/domain/map_patch.h>
+#include <warthog/domain/move_table.h>
+
+namespace
+{
+
+using warthog::domain::gridmap;
+
+// a 150x40 map with random obstacles
+void
+make_map(gridmap& map, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	for(uint32_t y = 0; y < map.header_height(); y++)
+		for(uint32_t x = 0; x < map.header_width(); x++)
+			map.set_label(x, y, rng() % 4 != 0);
+}
+
+bool
+same_cells(const gridmap& a, const gridmap& b)
+{
+	for(uint32_t y = 0; y < a.header_height(); y++)
+		for(uint32_t x = 0; x < a.header_width(); x++)
+			if(a.get_label(a.to_padded_id_from_unpadded(x, y))
+			   != b.get_label(b.to_padded_id_from_unpadded(x, y)))
+				return false;
+	return a.get_num_traversable_tiles() == b.get_num_traversable_tiles();
+}
+
+} // namespace
+
+TEST_CASE("gridmap::set_row writes unaligned rows", "[map_patch]")
+{
+	gridmap map(40, 150), expected(40, 150);
+	make_map(map, 1);
+	make_map(expected, 1);
+
+	// runs that start and end inside words and span several of them
+	std::mt19937 rng(2);
+	for(uint32_t i = 0; i < 200; i++)
+	{
+		uint32_t x = rng() % 150, y = rng() % 40;
+		uint32_t n = 1 + rng() % (150 - x);
+		uint64_t bits[3] = {rng() * 0x100000001ull, rng() * 0x100000001ull,
+		                    rng() * 0x100000001ull};
+		map.set_row(x, y, bits, n);
+		for(uint32_t k = 0; k < n; k++)
+		{
+			expected.set_label(x + k, y, (bits[k >> 6] >> (k & 63)) & 1);
+		}
+	}
+	REQUIRE(same_cells(map, expected));
+}
+
+TEST_CASE("apply_patches reads and applies patches", "[map_patch]")
+{
+	gridmap map(4, 5);
+	for(uint32_t x = 0; x < 5; x++)
+		for(uint32_t y = 0; y < 4; y++)
+			map.set_label(x, y, true);
+
+	std::istringstream in("type patch\npatches 2\nheight 2\nwidth 3\nmap\n"
+	                      "1 1\n@@@\n.T.\n"
+	                      "2 2\n...\n@G@\n");
+	REQUIRE(warthog::domain::apply_patches(in, map) == 2);
+	const char* rows[] = {".....", ".@@@.", ".....", "..@.@"};
+	for(uint32_t y = 0; y < 4; y++)
+		for(uint32_t x = 0; x < 5; x++)
+			REQUIRE(
+			    map.get_label(map.to_padded_id_from_unpadded(x, y))
+			    == (rows[y][x] == '.'));
+	REQUIRE(map.get_num_traversable_tiles() == 15);
+
+	// patches off the map, or with unknown cells, are rejected whole
+	warthog::io::grid_patch patch{4, 0, 2, 1, {'@', '@'}};
+	REQUIRE_FALSE(warthog::domain::apply_patch(map, patch));
+	patch = {0, 0, 2, 1, {'@', '?'}};
+	REQUIRE_FALSE(warthog::domain::apply_patch(map, patch));
+	REQUIRE(map.get_label(map.to_padded_id_from_unpadded(0, 0)));
+
+	std::istringstream bad("type octile\nheight 1\nwidth 1\nmap\n.\n");
+	REQUIRE_THROWS(warthog::domain::apply_patches(bad, map));
+}
+
+TEST_CASE("apply_patches keeps derived structures current", "[map_patch]")
+{
+	gridmap map(40, 150);
+	make_map(map, 3);
+	warthog::domain::move_table moves(map);
+	warthog::domain::grid_components components(map);
+
+	// a wall splitting the map is opened, then closed again
+	std::string wall = "type patch\npatches 1\nheight 40\nwidth 1\nmap\n70 0\n";
+	std::string door = "type patch\npatches 1\nheight 40\nwidth 1\nmap\n70 0\n";
+	for(uint32_t y = 0; y < 40; y++)
+	{
+		wall += "@\n";
+		door += ".\n";
+	}
+	for(const std::string& text : {wall, door, wall})
+	{
+		std::istringstream in(text);
+		warthog::domain::apply_patches(in, map, &moves, &components);
+
+		warthog::domain::move_table built(map);
+		warthog::domain::grid_components rebuilt(map);
+		for(uint32_t y = 0; y < 40; y++)
+		{
+			for(uint32_t x = 0; x < 150; x++)
+			{
+				auto id = map.to_padded_id_from_unpadded(x, y);
+				REQUIRE(moves.get(id) == built.get(id));
+				for(uint32_t dx : {1u, 7u, 100u})
+				{
+					auto other = map.to_padded_id_from_unpadded(
+					    (x + dx) % 150, (y + dx) % 40);
+					REQUIRE(
+					    components.connected(id, other)
+					    == rebuilt.connected(id, other));
+				}
+			}
+		}
+		REQUIRE(components.num_components() == rebuilt.num_components());
+		REQUIRE(components.largest() == rebuilt.largest());
+	}
+}
+
+TEST_CASE("grid_components::update merges opened cells", "[map_patch]")
+{
+	// two rooms joined by opening the cell between them
+	gridmap map(1, 5);
+	for(uint32_t x : {0u, 1u, 3u, 4u})
+		map.set_label(x, 0, true);
+	warthog::domain::grid_components components(map);
+	REQUIRE(components.num_components() == 2);
+
+	map.set_label(2, 0, true);
+	REQUIRE(components.update(map, 2, 0, 1, 1));
+	REQUIRE(components.num_components() == 1);
+	auto c = components.get(map.to_padded_id_from_unpadded(4, 0));
+	REQUIRE(components.size(c) == 5);
+	REQUIRE(components.largest() == 5);
+
+	// closing it again splits them; the components are rebuilt
+	map.set_label(2, 0, false);
+	REQUIRE_FALSE(components.update(map, 2, 0, 1, 1));
+	REQUIRE(components.num_components() == 2);
+}
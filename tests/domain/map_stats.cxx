@@ -0,0 +1,94 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <warthog/domain/grid_components.h>
+#include <warthog/domain/gridmap.h>
+#include <warthog/domain/map_stats.h>
+#include <warthog/util/scenario_manager.h>
+
+namespace
+{
+
+// a 10x6 map split in two by a wall at x = 4, with a corridor of width
+// one across the bottom of the right-hand side:
+//   ....@.....
+//   ....@.....
+//   ....@.....
+//   ....@@@@@@
+//   ....@.....
+//   ....@@@@@@
+void
+make_map(warthog::domain::gridmap& map)
+{
+	for(uint32_t y = 0; y < 6; y++)
+		for(uint32_t x = 0; x < 10; x++)
+		{
+			bool wall = x == 4 || (x > 4 && (y == 3 || y == 5));
+			map.set_label(x, y, !wall);
+		}
+}
+
+} // namespace
+
+TEST_CASE("grid_components labels connected cells", "[map_stats]")
+{
+	warthog::domain::gridmap map(6, 10);
+	make_map(map);
+	warthog::domain::grid_components comps(map);
+
+	REQUIRE(comps.num_components() == 3);
+	REQUIRE(comps.largest() == 24);
+	auto id = [&](uint32_t x, uint32_t y) {
+		return map.to_padded_id_from_unpadded(x, y);
+	};
+	REQUIRE(comps.connected(id(0, 0), id(3, 5)));
+	REQUIRE(comps.connected(id(5, 0), id(9, 2)));
+	REQUIRE_FALSE(comps.connected(id(0, 0), id(5, 0)));
+	REQUIRE_FALSE(comps.connected(id(5, 2), id(5, 4)));
+	REQUIRE(comps.get(id(4, 0)) == warthog::domain::grid_components::NONE);
+	REQUIRE(comps.size(comps.get(id(7, 4))) == 5);
+}
+
+TEST_CASE("map_stats summarises the map", "[map_stats]")
+{
+	warthog::domain::gridmap map(6, 10);
+	make_map(map);
+	warthog::domain::grid_components comps(map);
+	warthog::domain::map_stats stats(map, comps);
+
+	REQUIRE(stats.width_ == 10);
+	REQUIRE(stats.height_ == 6);
+	REQUIRE(stats.traversable_ == 44);
+	REQUIRE(map.get_num_traversable_tiles() == 44);
+	REQUIRE(stats.components_ == 3);
+	REQUIRE(stats.obstacle_density_ == Catch::Approx(16.0 / 60));
+	REQUIRE(stats.largest_share_ == Catch::Approx(24.0 / 44));
+	// the corners of the two rooms and the whole corridor have at most
+	// two open neighbours
+	REQUIRE(stats.corridor_ratio_ == Catch::Approx((4 + 4 + 5) / 44.0));
+}
+
+TEST_CASE("generated instances connect traversable cells", "[map_stats]")
+{
+	warthog::domain::gridmap map(6, 10);
+	make_map(map);
+	warthog::domain::grid_components comps(map);
+
+	warthog::util::scenario_manager scenmgr;
+	scenmgr.generate_experiments(&map, 50, 7);
+	REQUIRE(scenmgr.num_experiments() == 50);
+	for(uint32_t i = 0; i < scenmgr.num_experiments(); i++)
+	{
+		auto* exp = scenmgr.get_experiment(i);
+		REQUIRE(comps.connected(
+		    map.to_padded_id_from_unpadded(exp->startx(), exp->starty()),
+		    map.to_padded_id_from_unpadded(exp->goalx(), exp->goaly())));
+	}
+
+	// the same seed gives the same instances
+	warthog::util::scenario_manager again;
+	again.generate_experiments(&map, 50, 7);
+	REQUIRE(again.get_experiment(49)->startx()
+	        == scenmgr.get_experiment(49)->startx());
+	REQUIRE(again.get_experiment(49)->goaly()
+	        == scenmgr.get_experiment(49)->goaly());
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <warthog/domain/gridmap.h>
+#include <warthog/domain/versioned_gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/pqueue.h>
+
+namespace
+{
+
+// an open 64x64 map
+void
+make_map(warthog::domain::gridmap& map)
+{
+	for(uint32_t y = 0; y < map.header_height(); y++)
+		for(uint32_t x = 0; x < map.header_width(); x++)
+			map.set_label(x, y, true);
+}
+
+} // namespace
+
+TEST_CASE("versioned_gridmap snapshots do not change", "[versioned_gridmap]")
+{
+	warthog::domain::gridmap base(64, 64);
+	make_map(base);
+	warthog::domain::versioned_gridmap map(base);
+
+	auto v0 = map.acquire();
+	REQUIRE(v0.get_version() == 0);
+	REQUIRE(v0->get_num_traversable_tiles() == 64 * 64);
+
+	REQUIRE(map.commit({{3, 4, false}, {5, 6, false}, {5, 6, true}}) == 1);
+	auto v1 = map.acquire();
+	REQUIRE(v1.get_version() == 1);
+	REQUIRE(v0->get_label(v0->to_padded_id_from_unpadded(3, 4)));
+	REQUIRE_FALSE(v1->get_label(v1->to_padded_id_from_unpadded(3, 4)));
+	REQUIRE(v1->get_label(v1->to_padded_id_from_unpadded(5, 6)));
+	REQUIRE(v1->get_num_traversable_tiles() == 64 * 64 - 1);
+
+	// edits off the map are ignored
+	REQUIRE(map.commit({{64, 0, false}, {0, 64, false}}) == 2);
+	REQUIRE(map.acquire()->get_num_traversable_tiles() == 64 * 64 - 1);
+}
+
+TEST_CASE("versioned_gridmap reuses released copies", "[versioned_gridmap]")
+{
+	warthog::domain::gridmap base(256, 64);
+	make_map(base);
+	warthog::domain::versioned_gridmap map(base);
+	uint32_t blocks = (256 + 2 * warthog::domain::gridmap::PADDED_ROWS
+	                   + warthog::domain::versioned_gridmap::BLOCK_ROWS - 1)
+	    / warthog::domain::versioned_gridmap::BLOCK_ROWS;
+
+	// the first commit makes a full copy; later ones copy only the
+	// blocks changed since their copy was current
+	map.commit({{0, 0, false}});
+	REQUIRE(map.get_blocks_copied() == blocks);
+	map.commit({{0, 100, false}});
+	REQUIRE(map.get_blocks_copied() == blocks + 1);
+	map.commit({{1, 100, false}});
+	REQUIRE(map.get_blocks_copied() == blocks + 2);
+	REQUIRE(map.num_copies() == 2);
+
+	// a version still being read is not reused
+	{
+		auto held = map.acquire();
+		map.commit({{2, 100, false}});
+		map.commit({{3, 100, false}});
+		REQUIRE(map.num_copies() == 3);
+		REQUIRE(held.get_version() == 3);
+		REQUIRE(held->get_label(held->to_padded_id_from_unpadded(2, 100)));
+	}
+	map.commit({{4, 100, false}});
+	REQUIRE(map.num_copies() == 2);
+
+	auto cur = map.acquire();
+	for(uint32_t x = 0; x < 5; x++)
+	{
+		REQUIRE_FALSE(cur->get_label(cur->to_padded_id_from_unpadded(x, 100)));
+	}
+	REQUIRE(cur->get_num_traversable_tiles() == 256 * 64 - 6);
+}
+
+TEST_CASE("versioned_gridmap readers run during commits", "[versioned_gridmap]")
+{
+	warthog::domain::gridmap base(64, 64);
+	make_map(base);
+	warthog::domain::versioned_gridmap map(base);
+
+	// a wall at x = 32 is raised and lowered row by row. every commit
+	// changes one cell, so each version has an even or odd number of
+	// blocked cells according to its version number.
+	std::atomic<bool> done(false);
+	std::atomic<uint32_t> torn(0), solved(0);
+	std::vector<std::thread> readers;
+	for(uint32_t t = 0; t < 4; t++)
+	{
+		readers.emplace_back([&] {
+			auto snap = map.acquire();
+			warthog::search::gridmap_expansion_policy expander(snap.get());
+			warthog::heuristic::octile_heuristic heuristic(64, 64);
+			warthog::util::pqueue_min open;
+			warthog::search::unidirectional_search astar(
+			    &heuristic, &expander, &open);
+			warthog::search::search_parameters par;
+			while(!done)
+			{
+				snap = map.acquire();
+				expander.set_map(snap.get());
+				uint32_t blocked = 64 * 64 - snap->get_num_traversable_tiles();
+				if(blocked % 2 != snap.get_version() % 2) { torn++; }
+
+				warthog::search::problem_instance pi(
+				    expander.get_pack(0, 0), expander.get_pack(63, 63));
+				warthog::search::solution sol;
+				astar.get_path(&pi, &par, &sol);
+				if(sol.sum_of_edge_costs_ != warthog::COST_MAX) { solved++; }
+			}
+		});
+	}
+	for(uint32_t i = 0; i < 2000; i++)
+	{
+		uint32_t y = i % 63;
+		map.commit({{32, y, (i / 63) % 2 == 1}});
+	}
+	done = true;
+	for(auto& t : readers)
+	{
+		t.join();
+	}
+	REQUIRE(torn == 0);
+	REQUIRE(solved > 0);
+
+	// the versions the readers held are reclaimed by the next commit
+	map.commit({});
+	REQUIRE(map.num_copies() == 2);
+}
@@ -0,0 +1,380 @@
+// tests/perf/perf.cxx
+//
+// Performance regression suite. Runs fixed workloads on synthetic maps
+// and compares them with a stored baseline. Nodes expanded and generated
+// are deterministic: any change fails.
+//
+// Times are checked only with a tolerance, in percent, above 0. Each
+// repeat of a workload is followed by a reference kernel (a heap and a
+// pointer chase, the two costs of a search) and the time is the median,
+// over the repeats, of the workload's time relative to the kernel's. The
+// ratio carries over between machines far better than wall time; it fails
+// when it is larger than the baseline's by more than the tolerance.
+//
+// usage: warthog_perf --baseline FILE [--tolerance PCT] [--repeat N]
+//                     [--update]
+//
+// --update writes the current counts and ratios to the baseline instead
+// of checking them. Counts are for the default build options; ratios are
+// for an optimised build.
+//
+// @author: dharabor
+// @created: 2026-10-18
+//
+
+#include <warthog/domain/grid_components.h>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/fringe_search.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/lazy_pqueue.h>
+#include <warthog/util/packed_pqueue.h>
+#include <warthog/util/pqueue.h>
+#include <warthog/util/timer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using warthog::domain::gridmap;
+
+constexpr uint32_t MAP_SIZE    = 256;
+constexpr uint32_t NUM_QUERIES = 300;
+
+struct totals
+{
+	uint64_t expanded_  = 0;
+	uint64_t generated_ = 0;
+	uint64_t usec_      = 0; // median wall time
+	double ratio_       = 0; // median time relative to the reference
+};
+
+// obstacles with probability @param pct percent. std::mt19937 is used
+// directly as its sequence, unlike the standard distributions, is the
+// same on every platform.
+void
+random_map(gridmap& map, uint32_t pct, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	for(uint32_t y = 0; y < MAP_SIZE; y++)
+		for(uint32_t x = 0; x < MAP_SIZE; x++)
+			map.set_label(x, y, rng() % 100 >= pct);
+}
+
+// 32x32 rooms joined by a door in each wall, with scattered obstacles
+void
+rooms_map(gridmap& map, uint32_t seed)
+{
+	random_map(map, 5, seed);
+	std::mt19937 rng(seed + 1);
+	for(uint32_t w = 31; w < MAP_SIZE; w += 32)
+	{
+		for(uint32_t i = 0; i < MAP_SIZE; i++)
+		{
+			map.set_label(w, i, false);
+			map.set_label(i, w, false);
+		}
+		for(uint32_t r = 0; r < MAP_SIZE; r += 32)
+		{
+			map.set_label(w, r + rng() % 31, true);
+			map.set_label(r + rng() % 31, w, true);
+		}
+	}
+}
+
+// start and target pairs that are connected
+std::vector<warthog::search::problem_instance>
+make_queries(gridmap& map, uint32_t seed)
+{
+	warthog::domain::grid_components components(map);
+	std::mt19937 rng(seed);
+	std::vector<warthog::search::problem_instance> queries;
+	while(queries.size() < NUM_QUERIES)
+	{
+		uint32_t sx = rng() % MAP_SIZE, sy = rng() % MAP_SIZE;
+		uint32_t tx = rng() % MAP_SIZE, ty = rng() % MAP_SIZE;
+		warthog::pad_id s = map.to_padded_id_from_unpadded(sx, sy);
+		warthog::pad_id t = map.to_padded_id_from_unpadded(tx, ty);
+		if(s == t || !components.connected(s, t)) { continue; }
+		queries.emplace_back(
+		    warthog::pack_id{sy * MAP_SIZE + sx},
+		    warthog::pack_id{ty * MAP_SIZE + tx});
+	}
+	return queries;
+}
+
+// the reference kernel: a binary heap and a walk of a random cycle
+// through memory, sized like the workloads. returns its time in usec.
+uint64_t
+reference()
+{
+	constexpr uint32_t N = 1 << 20;
+	static std::vector<uint32_t> next;
+	if(next.empty())
+	{
+		// Sattolo's algorithm, so the walk visits every entry
+		std::mt19937 rng(3);
+		next.resize(N);
+		std::iota(next.begin(), next.end(), 0);
+		for(uint32_t i = N - 1; i > 0; i--)
+		{
+			std::swap(next[i], next[rng() % i]);
+		}
+	}
+
+	warthog::util::timer timer;
+	timer.start();
+	std::priority_queue<uint32_t> heap;
+	uint32_t at = 0;
+	for(uint32_t i = 0; i < N; i++)
+	{
+		at = next[at];
+		heap.push(at);
+		if(i & 1) { heap.pop(); }
+	}
+	volatile uint32_t sink = heap.top() + at;
+	(void)sink;
+	return timer.elapsed_time_nano().count() / 1000;
+}
+
+template<class T>
+T
+median(std::vector<T> v)
+{
+	std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+	return v[v.size() / 2];
+}
+
+// every query, @param repeat times, each followed by the reference
+// kernel. counts are from the first repeat.
+template<class S>
+totals
+run(S& search, std::vector<warthog::search::problem_instance>& queries,
+    double weight, uint32_t repeat)
+{
+	totals t;
+	std::vector<uint64_t> usec;
+	std::vector<double> ratio;
+	warthog::search::search_parameters par;
+	par.set_w_admissibility(weight);
+	for(uint32_t r = 0; r < repeat; r++)
+	{
+		uint64_t expanded = 0, generated = 0;
+		warthog::util::timer timer;
+		timer.start();
+		for(auto& pi : queries)
+		{
+			warthog::search::solution sol;
+			search.get_path(&pi, &par, &sol);
+			expanded += sol.met_.nodes_expanded_;
+			generated += sol.met_.nodes_generated_;
+		}
+		usec.push_back(timer.elapsed_time_nano().count() / 1000);
+		uint64_t ref = std::max<uint64_t>(1, reference());
+		ratio.push_back((double)usec.back() / ref);
+		if(r == 0)
+		{
+			t.expanded_  = expanded;
+			t.generated_ = generated;
+		}
+	}
+	t.usec_  = median(usec);
+	t.ratio_ = median(ratio);
+	return t;
+}
+
+template<class Q>
+totals
+astar(gridmap& map, double weight, uint32_t seed, uint32_t repeat)
+{
+	auto queries = make_queries(map, seed);
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	Q open;
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, Q,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::w_admissible>
+	    search(&heuristic, &expander, &open);
+	return run(search, queries, weight, repeat);
+}
+
+totals
+fringe(gridmap& map, uint32_t seed, uint32_t repeat)
+{
+	auto queries = make_queries(map, seed);
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::search::fringe_search search(&heuristic, &expander);
+	return run(search, queries, 1, repeat);
+}
+
+using workload = std::function<totals(uint32_t repeat)>;
+
+std::vector<std::pair<std::string, workload>>
+workloads(gridmap& random, gridmap& rooms)
+{
+	using warthog::util::lazy_pqueue;
+	using warthog::util::packed_pqueue;
+	using warthog::util::pqueue_min;
+	return {
+	    {"astar_random",
+	     [&](uint32_t n) { return astar<pqueue_min>(random, 1, 11, n); }},
+	    {"astar_rooms",
+	     [&](uint32_t n) { return astar<pqueue_min>(rooms, 1, 12, n); }},
+	    {"astar_packed_random",
+	     [&](uint32_t n) { return astar<packed_pqueue<>>(random, 1, 11, n); }},
+	    {"astar_lazy_random",
+	     [&](uint32_t n) { return astar<lazy_pqueue<>>(random, 1, 11, n); }},
+	    {"wastar_rooms",
+	     [&](uint32_t n) { return astar<pqueue_min>(rooms, 2, 12, n); }},
+	    {"fringe_rooms", [&](uint32_t n) { return fringe(rooms, 12, n); }},
+	};
+}
+
+std::map<std::string, totals>
+read_baseline(const char* file)
+{
+	std::map<std::string, totals> baseline;
+	std::ifstream in(file);
+	std::string line;
+	while(std::getline(in, line))
+	{
+		if(line.empty() || line[0] == '#') { continue; }
+		std::istringstream fields(line);
+		std::string name;
+		totals t;
+		if(fields >> name >> t.expanded_ >> t.generated_ >> t.ratio_)
+		{
+			baseline[name] = t;
+		}
+	}
+	return baseline;
+}
+
+void
+help()
+{
+	std::cerr << "usage: warthog_perf --baseline FILE [--tolerance PCT] "
+	             "[--repeat N] [--update]\n";
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+	const char* baseline_file = nullptr;
+	double tolerance          = 0;
+	uint32_t repeat           = 5;
+	bool update               = false;
+	for(int i = 1; i < argc; i++)
+	{
+		if(std::strcmp(argv[i], "--update") == 0) { update = true; }
+		else if(i + 1 < argc && std::strcmp(argv[i], "--baseline") == 0)
+		{
+			baseline_file = argv[++i];
+		}
+		else if(i + 1 < argc && std::strcmp(argv[i], "--tolerance") == 0)
+		{
+			tolerance = std::atof(argv[++i]);
+		}
+		else if(i + 1 < argc && std::strcmp(argv[i], "--repeat") == 0)
+		{
+			repeat = std::max(1, std::atoi(argv[++i]));
+		}
+		else
+		{
+			help();
+			return 2;
+		}
+	}
+	if(!baseline_file)
+	{
+		help();
+		return 2;
+	}
+
+	gridmap random(MAP_SIZE, MAP_SIZE), rooms(MAP_SIZE, MAP_SIZE);
+	random_map(random, 30, 1);
+	rooms_map(rooms, 2);
+
+	std::map<std::string, totals> baseline = read_baseline(baseline_file);
+	std::ostringstream updated;
+	updated << "# workload expanded generated ratio\n";
+	uint32_t failed = 0;
+	std::cout << std::left << std::setw(22) << "workload" << std::right
+	          << std::setw(12) << "expanded" << std::setw(12) << "generated"
+	          << std::setw(10) << "usec" << std::setw(8) << "ratio"
+	          << std::setw(8) << "base" << std::setw(9) << "change" << "\n";
+	for(auto& [name, fn] : workloads(random, rooms))
+	{
+		totals t = fn(repeat);
+		updated << name << " " << t.expanded_ << " " << t.generated_ << " "
+		        << std::fixed << std::setprecision(3) << t.ratio_ << "\n";
+		std::cout << std::left << std::setw(22) << name << std::right
+		          << std::setw(12) << t.expanded_ << std::setw(12)
+		          << t.generated_ << std::setw(10) << t.usec_ << std::fixed
+		          << std::setprecision(3) << std::setw(8) << t.ratio_;
+		if(update)
+		{
+			std::cout << "\n";
+			continue;
+		}
+
+		auto it = baseline.find(name);
+		if(it == baseline.end())
+		{
+			std::cout << "  FAIL: no baseline\n";
+			failed++;
+			continue;
+		}
+		const totals& b = it->second;
+		double change   = b.ratio_ ? 100.0 * t.ratio_ / b.ratio_ - 100 : 0;
+		std::cout << std::setw(8) << b.ratio_ << std::setw(8)
+		          << std::setprecision(1) << std::showpos << change << "%"
+		          << std::noshowpos;
+		if(t.expanded_ != b.expanded_ || t.generated_ != b.generated_)
+		{
+			std::cout << "  FAIL: counts were " << b.expanded_ << " "
+			          << b.generated_;
+			failed++;
+		}
+		else if(tolerance > 0 && change > tolerance)
+		{
+			std::cout << "  FAIL: slower than " << tolerance << "%";
+			failed++;
+		}
+		std::cout << "\n";
+	}
+
+	if(update)
+	{
+		std::ofstream out(baseline_file);
+		out << updated.str();
+		if(!out)
+		{
+			std::cerr << "cannot write " << baseline_file << "\n";
+			return 2;
+		}
+		return 0;
+	}
+	return failed ? 1 : 0;
+}
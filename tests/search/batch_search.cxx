@@ -0,0 +1,166 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/batch_search.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/lazy_pqueue.h>
+#include <warthog/util/pqueue.h>
+#include <warthog/util/scenario_manager.h>
+
+TEST_CASE("batch_search matches unidirectional_search", "[batch]")
+{
+	// 64x64 map with random obstacles
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(29);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 30);
+
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+
+	// a batch larger than the number of lanes, including blocked cells
+	std::vector<warthog::search::problem_instance> pis;
+	std::uniform_int_distribution<uint32_t> cell(0, width * height - 1);
+	for(int i = 0; i < 50; i++)
+	{
+		pis.emplace_back(
+		    warthog::pack_id{cell(rng)}, warthog::pack_id{cell(rng)});
+	}
+
+	uint32_t lanes = GENERATE(1, 3, 8);
+	warthog::search::gridmap_expansion_policy e1(&map), e2(&map), e3(&map),
+	    e4(&map), e5(&map), e6(&map), e7(&map), e8(&map);
+	std::vector<warthog::search::gridmap_expansion_policy*> expanders
+	    = {&e1, &e2, &e3, &e4, &e5, &e6, &e7, &e8};
+	expanders.resize(lanes);
+	warthog::search::batch_search batch(&heuristic, expanders);
+	REQUIRE(batch.get_num_lanes() == lanes);
+
+	// instances started in reverse order are solved the same way
+	bool reversed = GENERATE(false, true);
+	std::vector<uint32_t> order;
+	for(uint32_t i = (uint32_t)pis.size(); i-- > 0;)
+	{
+		order.push_back(i);
+	}
+
+	warthog::search::search_parameters par;
+	std::vector<warthog::search::solution> sols;
+	batch.get_paths(pis, &par, sols, reversed ? &order : nullptr);
+	REQUIRE(sols.size() == pis.size());
+
+	uint32_t solved = 0;
+	for(size_t i = 0; i < pis.size(); i++)
+	{
+		warthog::search::problem_instance pi{pis[i].start_, pis[i].target_};
+		warthog::search::solution sol;
+		astar.get_path(&pi, &par, &sol);
+
+		REQUIRE(sols[i].sum_of_edge_costs_ == sol.sum_of_edge_costs_);
+		REQUIRE(sols[i].met_.nodes_expanded_ == sol.met_.nodes_expanded_);
+		REQUIRE(sols[i].path_ == sol.path_);
+		if(sol.sum_of_edge_costs_ != warthog::COST_MAX) { solved++; }
+	}
+	REQUIRE(solved > 10);
+}
+
+TEST_CASE("batch_search matches unidirectional_search on a scenario", "[batch]")
+{
+	// a map and scenario written to disk and read back, as by the app
+	auto dir      = std::filesystem::temp_directory_path();
+	auto map_path = dir / "warthog_test_batch.map";
+	auto scen_path = dir / "warthog_test_batch.map.scen";
+	uint32_t width = 48, height = 40;
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> coin(0, 99);
+	{
+		std::ofstream out(map_path);
+		out << "type octile\nheight " << height << "\nwidth " << width
+		    << "\nmap\n";
+		for(uint32_t y = 0; y < height; y++)
+		{
+			for(uint32_t x = 0; x < width; x++)
+				out << (coin(rng) >= 25 ? '.' : '@');
+			out << "\n";
+		}
+	}
+	{
+		std::ofstream out(scen_path);
+		out << "version 1\n";
+		std::uniform_int_distribution<uint32_t> cx(0, width - 1),
+		    cy(0, height - 1);
+		for(int i = 0; i < 40; i++)
+		{
+			out << "0\twarthog_test_batch.map\t" << width << "\t" << height
+			    << "\t" << cx(rng) << "\t" << cy(rng) << "\t" << cx(rng)
+			    << "\t" << cy(rng) << "\t0\n";
+		}
+	}
+
+	warthog::util::scenario_manager scenmgr;
+	scenmgr.load_scenario(scen_path.string().c_str());
+	REQUIRE(scenmgr.num_experiments() == 40);
+	warthog::domain::gridmap map(map_path.string().c_str());
+	std::filesystem::remove(map_path);
+	std::filesystem::remove(scen_path);
+
+	// with an open list that has no decrease_key, as well
+	using Q = warthog::util::lazy_pqueue<>;
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::search::gridmap_expansion_policy expander(&map);
+	Q open;
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, Q,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::any,
+	    warthog::search::feasibility_criteria::until_cutoff>
+	    astar(&heuristic, &expander, &open);
+
+	std::vector<warthog::search::problem_instance> pis;
+	for(uint32_t i = 0; i < scenmgr.num_experiments(); i++)
+	{
+		warthog::util::experiment* exp = scenmgr.get_experiment(i);
+		pis.emplace_back(
+		    expander.get_pack(exp->startx(), exp->starty()),
+		    expander.get_pack(exp->goalx(), exp->goaly()));
+	}
+
+	warthog::search::gridmap_expansion_policy e1(&map), e2(&map), e3(&map);
+	std::vector<warthog::search::gridmap_expansion_policy*> expanders
+	    = {&e1, &e2, &e3};
+	warthog::search::batch_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, Q>
+	    batch(&heuristic, expanders);
+
+	warthog::search::search_parameters par;
+	std::vector<warthog::search::solution> sols;
+	batch.get_paths(pis, &par, sols);
+
+	uint32_t solved = 0;
+	for(size_t i = 0; i < pis.size(); i++)
+	{
+		warthog::search::problem_instance pi{pis[i].start_, pis[i].target_};
+		warthog::search::solution sol;
+		astar.get_path(&pi, &par, &sol);
+
+		REQUIRE(sols[i].sum_of_edge_costs_ == sol.sum_of_edge_costs_);
+		REQUIRE(sols[i].met_.nodes_expanded_ == sol.met_.nodes_expanded_);
+		REQUIRE(sols[i].met_.nodes_generated_ == sol.met_.nodes_generated_);
+		REQUIRE(sols[i].path_ == sol.path_);
+		if(sol.sum_of_edge_costs_ != warthog::COST_MAX) { solved++; }
+	}
+	REQUIRE(solved > 10);
+}
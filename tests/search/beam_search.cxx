@@ -0,0 +1,132 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/beam_search.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/minmax_heap.h>
+#include <warthog/util/pqueue.h>
+
+namespace
+{
+
+using warthog::search::beam_policy;
+
+// records the largest size of the open lists, at every expansion
+struct beam_listener
+{
+	warthog::util::minmax_heap_min* open = nullptr;
+	warthog::util::minmax_heap_min* next = nullptr;
+	size_t max_open                      = 0;
+
+	void
+	generate_node(
+	    warthog::search::search_node*, warthog::search::search_node*,
+	    warthog::cost_t, uint32_t)
+	{
+		max_open = std::max<size_t>(max_open, open->size());
+		max_open = std::max<size_t>(max_open, next->size());
+	}
+
+	void
+	expand_node(warthog::search::search_node*)
+	{ }
+
+	void
+	relax_node(warthog::search::search_node*)
+	{ }
+};
+
+// 64x64 map with random obstacles and open corners
+void
+random_map(warthog::domain::gridmap& map, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < map.header_height(); y++)
+		for(uint32_t x = 0; x < map.header_width(); x++)
+			map.set_label(x, y, coin(rng) >= 20);
+	map.set_label(1, 1, true);
+	map.set_label(map.header_width() - 2, map.header_height() - 2, true);
+}
+
+template<beam_policy BP>
+void
+check_beam_width(uint32_t beam_width)
+{
+	warthog::domain::gridmap map(64, 64);
+	random_map(map, 5);
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::minmax_heap_min open;
+	warthog::util::minmax_heap_min next;
+	beam_listener listener;
+	listener.open = &open;
+	listener.next = &next;
+
+	warthog::search::beam_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy,
+	    warthog::util::minmax_heap_min, beam_listener, BP>
+	    beam(&heuristic, &expander, &open, beam_width, &next, &listener);
+	warthog::search::search_parameters par;
+	warthog::search::problem_instance pi(
+	    expander.get_pack(1, 1), expander.get_pack(62, 62));
+	warthog::search::solution sol;
+	beam.get_path(&pi, &par, &sol);
+
+	REQUIRE(sol.met_.nodes_pruned_ > 0);
+	REQUIRE(listener.max_open <= beam_width);
+	REQUIRE(open.size() <= beam_width);
+	REQUIRE(next.size() <= beam_width);
+
+	// expanded nodes are deleted along with their successors
+	REQUIRE(beam.get_peak_nodes() < sol.met_.nodes_expanded_);
+}
+
+} // namespace
+
+TEST_CASE("beam_search caps OPEN at the beam width", "[beam]")
+{
+	SECTION("global") { check_beam_width<beam_policy::global>(8); }
+	SECTION("layered") { check_beam_width<beam_policy::layered>(8); }
+}
+
+TEST_CASE("beam_search with a wide beam is optimal", "[beam]")
+{
+	warthog::domain::gridmap map(64, 64);
+	random_map(map, 9);
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min astar_open;
+	warthog::search::unidirectional_search astar(
+	    &heuristic, &expander, &astar_open);
+	warthog::util::minmax_heap_min open;
+	warthog::search::beam_search beam(&heuristic, &expander, &open, 1 << 16);
+	warthog::search::search_parameters par;
+
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<uint32_t> coord(0, 63);
+	for(int i = 0; i < 50; i++)
+	{
+		auto start  = expander.get_pack(coord(rng), coord(rng));
+		auto target = expander.get_pack(coord(rng), coord(rng));
+		warthog::search::problem_instance pi(start, target);
+		warthog::search::solution opt;
+		astar.get_path(&pi, &par, &opt);
+
+		warthog::search::problem_instance pi2(start, target);
+		warthog::search::solution sol;
+		beam.get_path(&pi2, &par, &sol);
+		REQUIRE(sol.met_.nodes_pruned_ == 0);
+		REQUIRE(
+		    sol.sum_of_edge_costs_ == Catch::Approx(opt.sum_of_edge_costs_));
+		if(sol.sum_of_edge_costs_ != warthog::COST_MAX)
+		{
+			REQUIRE(sol.path_.front() == start);
+			REQUIRE(sol.path_.back() == target);
+		}
+	}
+}
@@ -0,0 +1,155 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/compact_path.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/pqueue.h>
+
+namespace
+{
+
+using warthog::pack_id;
+using warthog::search::compact_path;
+
+// a random walk of @param length steps on a map @param width cells wide
+std::vector<pack_id>
+random_walk(uint32_t width, uint32_t height, uint32_t length, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> dir(0, 7);
+	std::uniform_int_distribution<int> repeat(0, 40);
+	int32_t x = width / 2, y = height / 2;
+	std::vector<pack_id> path{pack_id{y * width + x}};
+	while(path.size() <= length)
+	{
+		auto d     = static_cast<warthog::grid::direction_id>(dir(rng));
+		int32_t dx = warthog::grid::dir_id_dx(d);
+		int32_t dy = warthog::grid::dir_id_dy(d);
+		for(int r = repeat(rng); r >= 0 && path.size() <= length; r--)
+		{
+			if(x + dx < 0 || x + dx >= (int32_t)width || y + dy < 0
+			   || y + dy >= (int32_t)height)
+			{
+				break;
+			}
+			x += dx;
+			y += dy;
+			path.push_back(pack_id{y * width + x});
+		}
+	}
+	return path;
+}
+
+} // namespace
+
+TEST_CASE("compact_path round trip", "[compact_path]")
+{
+	uint32_t width  = GENERATE(2u, 7u, 512u);
+	uint32_t length = GENERATE(0u, 1u, 100u, 20000u);
+	auto path       = random_walk(width, 512, length, width * 31 + length);
+
+	compact_path cp;
+	REQUIRE(cp.encode(path, width));
+	REQUIRE(cp.size() == path.size());
+	REQUIRE(cp.num_runs() <= path.size());
+	REQUIRE(cp.start() == path.front());
+	REQUIRE(cp.back() == path.back());
+
+	std::vector<pack_id> decoded;
+	cp.decode(decoded);
+	REQUIRE(decoded == path);
+
+	std::vector<pack_id> iterated(cp.begin(), cp.end());
+	REQUIRE(iterated == path);
+
+	std::stringstream buf;
+	cp.write(buf);
+	compact_path read;
+	REQUIRE(read.read(buf));
+	REQUIRE(read == cp);
+	REQUIRE(read.size() == cp.size());
+	REQUIRE(read.back() == cp.back());
+}
+
+TEST_CASE("compact_path rejects truncated streams", "[compact_path]")
+{
+	// a count of 2^32 - 1 runs, followed by a single run
+	std::stringstream buf;
+	const char header[] = {0, 0, 0, 0, 8, 0, 0, 0, -1, -1, -1, -1, 2, 0};
+	buf.write(header, sizeof(header));
+	compact_path read;
+	REQUIRE_FALSE(read.read(buf));
+	REQUIRE(read.num_runs() == 0);
+}
+
+TEST_CASE("compact_path rejects a zero width", "[compact_path]")
+{
+	// start 5, width 0, and a single run
+	std::stringstream buf;
+	const char header[] = {5, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 2, 0};
+	buf.write(header, sizeof(header));
+	compact_path read;
+	REQUIRE_FALSE(read.read(buf));
+	REQUIRE(read.empty());
+}
+
+TEST_CASE("compact_path long runs", "[compact_path]")
+{
+	compact_path cp;
+	cp.reset(pack_id{0}, 100000);
+	cp.push_back(warthog::grid::EAST_ID, compact_path::MAX_RUN * 2 + 5);
+	cp.push_back(warthog::grid::EAST_ID);
+	REQUIRE(cp.num_runs() == 3);
+	REQUIRE(cp.num_steps() == compact_path::MAX_RUN * 2 + 6);
+	REQUIRE(cp.back() == pack_id{compact_path::MAX_RUN * 2 + 6});
+	REQUIRE(cp.cost() == compact_path::MAX_RUN * 2 + 6);
+}
+
+TEST_CASE("compact_path rejects gaps", "[compact_path]")
+{
+	compact_path cp;
+	REQUIRE(!cp.encode({pack_id{0}, pack_id{2}}, 10));
+	REQUIRE(cp.empty());
+	REQUIRE(!cp.encode({pack_id{0}, pack_id{0}}, 10));
+}
+
+TEST_CASE("compact_path from search", "[compact_path]")
+{
+	// a 32x32 map with a wall that has a single gap
+	warthog::domain::gridmap map(32, 32);
+	for(uint32_t y = 0; y < 32; y++)
+		for(uint32_t x = 0; x < 32; x++)
+			map.set_label(x, y, x != 16 || y == 30);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::search_parameters par;
+
+	warthog::search::problem_instance pi(
+	    expander.get_pack(2, 3), expander.get_pack(29, 5));
+	warthog::search::solution sol;
+	astar.get_path(&pi, &par, &sol);
+	REQUIRE(sol.path_.size() > 1);
+
+	compact_path cp;
+	warthog::search::problem_instance pi2(
+	    expander.get_pack(2, 3), expander.get_pack(29, 5));
+	warthog::search::solution sol2;
+	astar.get_path(&pi2, &par, &sol2, &cp);
+	REQUIRE(sol2.path_.empty());
+	REQUIRE(sol2.sum_of_edge_costs_ == sol.sum_of_edge_costs_);
+
+	std::vector<pack_id> decoded;
+	cp.decode(decoded);
+	REQUIRE(decoded == sol.path_);
+	REQUIRE(cp.cost() == Catch::Approx(sol.sum_of_edge_costs_));
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+#include <warthog/constants.h>
+#include <warthog/domain/gridmap.h>
+#include <warthog/search/cost_predictor.h>
+
+TEST_CASE("cost_predictor features", "[predictor]")
+{
+	// 64x32 map; the left half is open, the right half is a separate
+	// room whose top half is solid
+	uint32_t width = 64, height = 32;
+	warthog::domain::gridmap map(height, width);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+		{
+			bool wall = x == 32 || (x > 32 && y < 16);
+			map.set_label(x, y, !wall);
+		}
+	warthog::search::cost_predictor predictor(map, 16);
+
+	auto f = predictor.features(0, 0, 30, 10);
+	REQUIRE(f.connected_);
+	REQUIRE(f.octile_ == Catch::Approx(20 + 10 * warthog::DBL_ROOT_TWO));
+	REQUIRE(f.density_ < 0.01);
+	REQUIRE(f.component_size_ == 32 * 32);
+
+	// through the solid block, into the other room
+	auto g = predictor.features(20, 4, 60, 28);
+	REQUIRE_FALSE(g.connected_);
+	REQUIRE(g.density_ > 0.1);
+	REQUIRE(g.density_ < 0.9);
+	// unsolvable: A* expands the whole component of the start
+	REQUIRE(predictor.expansions(g) == 32 * 32);
+
+	// longer queries are predicted to cost more
+	auto near = predictor.features(0, 0, 3, 3);
+	REQUIRE(predictor.expansions(near) < predictor.expansions(f));
+	REQUIRE(predictor.nanos(near) < predictor.nanos(f));
+}
+
+TEST_CASE("cost_predictor fits its model", "[predictor]")
+{
+	warthog::domain::gridmap map(8, 8);
+	warthog::search::cost_predictor predictor(map);
+
+	// expansions drawn from a known model
+	warthog::search::cost_model truth;
+	truth.w_ = {0.5, 1.3, 2.0, 0.1};
+	std::vector<warthog::search::query_features> features;
+	std::vector<double> expanded, nanos;
+	for(uint32_t i = 0; i < 40; i++)
+	{
+		warthog::search::query_features f{
+		    (double)(i * 7 % 97), (i % 5) / 5.0, 100 + 50 * (i % 3), true};
+		double y = truth.w_[0] + truth.w_[1] * std::log1p(f.octile_)
+		    + truth.w_[2] * f.density_
+		    + truth.w_[3] * std::log(f.component_size_);
+		features.push_back(f);
+		expanded.push_back(std::expm1(y));
+		nanos.push_back(50 * std::expm1(y));
+	}
+	predictor.fit(features, expanded, nanos);
+
+	const warthog::search::cost_model& m = predictor.get_model();
+	REQUIRE(m.nanos_per_expansion_ == Catch::Approx(50));
+	for(size_t i = 0; i < features.size(); i++)
+	{
+		REQUIRE(
+		    predictor.expansions(features[i])
+		    == Catch::Approx(expanded[i]).epsilon(0.01));
+	}
+
+	// too few queries to fit; the model is kept
+	predictor.set_model(truth);
+	features.resize(3);
+	predictor.fit(features, expanded, nanos);
+	REQUIRE(predictor.get_model().w_ == truth.w_);
+}
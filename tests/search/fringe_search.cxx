@@ -0,0 +1,59 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/fringe_search.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/pqueue.h>
+
+TEST_CASE("fringe_search finds optimal paths", "[fringe]")
+{
+	// 64x64 map with random obstacles
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(23);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 30);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, warthog::util::pqueue_min,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::w_admissible>
+	    astar(&heuristic, &expander, &open);
+	warthog::search::fringe_search fringe(&heuristic, &expander);
+	warthog::search::search_parameters par;
+
+	uint32_t solved = 0;
+	std::uniform_int_distribution<uint32_t> cell(0, width * height - 1);
+	for(int i = 0; i < 100; i++)
+	{
+		warthog::pack_id s{cell(rng)}, t{cell(rng)};
+		if(!map.get_label(map.to_padded_id(s))
+		   || !map.get_label(map.to_padded_id(t)))
+		{
+			continue;
+		}
+		warthog::search::problem_instance pi1{s, t};
+		warthog::search::problem_instance pi2{s, t};
+		warthog::search::solution sol1, sol2;
+		astar.get_path(&pi1, &par, &sol1);
+		fringe.get_path(&pi2, &par, &sol2);
+
+		REQUIRE(
+		    sol1.sum_of_edge_costs_
+		    == Catch::Approx(sol2.sum_of_edge_costs_));
+		if(sol2.sum_of_edge_costs_ == warthog::COST_MAX) { continue; }
+		REQUIRE(sol2.path_.front() == s);
+		REQUIRE(sol2.path_.back() == t);
+		solved++;
+	}
+	REQUIRE(solved > 10);
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <set>
+#include <utility>
+#include <warthog/constants.h>
+#include <warthog/domain/gridmap.h>
+#include <warthog/domain/move_table.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/problem_instance.h>
+
+TEST_CASE("gridmap_expansion_policy generates the legal moves", "[expand]")
+{
+	// wider than one 64-bit word per row
+	uint32_t width = 100, height = 40;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(31);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 35);
+
+	// moves from the map itself, or from a precomputed table
+	warthog::domain::move_table table(map);
+	bool manhattan = GENERATE(false, true);
+	bool use_table = GENERATE(false, true);
+	warthog::search::gridmap_expansion_policy expander(
+	    &map, manhattan, use_table ? &table : nullptr);
+	warthog::search::search_problem_instance spi{
+	    warthog::pad_id{0}, warthog::pad_id{0}};
+
+	auto open = [&](int32_t x, int32_t y) {
+		return x >= 0 && y >= 0 && x < (int32_t)width && y < (int32_t)height
+		    && map.get_label(map.to_padded_id_from_unpadded(x, y));
+	};
+
+	for(int32_t y = 0; y < (int32_t)height; y++)
+		for(int32_t x = 0; x < (int32_t)width; x++)
+		{
+			if(!open(x, y)) { continue; }
+
+			// moves by the rules: no corner cutting
+			std::set<std::pair<uint32_t, warthog::cost_t>> expected;
+			for(int32_t dy = -1; dy <= 1; dy++)
+				for(int32_t dx = -1; dx <= 1; dx++)
+				{
+					if((!dx && !dy) || !open(x + dx, y + dy)) { continue; }
+					if(dx && dy)
+					{
+						if(manhattan || !open(x + dx, y) || !open(x, y + dy))
+						{
+							continue;
+						}
+					}
+					expected.insert(
+					    {(uint32_t)expander.get_pad(x + dx, y + dy).id,
+					     (warthog::cost_t)(dx && dy ? warthog::DBL_ROOT_TWO
+					                                : 1.0)});
+				}
+
+			std::set<std::pair<uint32_t, warthog::cost_t>> generated;
+			expander.expand(expander.generate(expander.get_pad(x, y)), &spi);
+			for(uint32_t i = 0; i < expander.get_num_successors(); i++)
+			{
+				warthog::search::search_node* n;
+				warthog::cost_t cost;
+				expander.get_successor(i, n, cost);
+				generated.insert({(uint32_t)n->get_id().id, cost});
+			}
+			REQUIRE(generated == expected);
+		}
+}
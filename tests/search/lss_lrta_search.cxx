@@ -0,0 +1,78 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <random>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/lss_lrta_search.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/pqueue.h>
+
+TEST_CASE("lss_lrta_search reaches the target and learns", "[lss_lrta]")
+{
+	// 40x40 map with random obstacles
+	uint32_t width = 40, height = 40;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(5);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 25);
+	map.set_label(1, 1, true);
+	map.set_label(width - 2, height - 2, true);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::search_parameters par;
+
+	auto start  = expander.get_pack(1, 1);
+	auto target = expander.get_pack(width - 2, height - 2);
+	warthog::search::problem_instance pi(start, target);
+	warthog::search::solution opt;
+	astar.get_path(&pi, &par, &opt);
+	REQUIRE(opt.sum_of_edge_costs_ != warthog::COST_MAX);
+
+	uint32_t lookahead = GENERATE(1u, 8u, 64u);
+	warthog::search::lss_lrta_search lrta(
+	    &heuristic, &expander, &open, lookahead);
+
+	warthog::cost_t previous = warthog::COST_MAX;
+	bool converged  = false;
+	for(int trial = 0; trial < 500 && !converged; trial++)
+	{
+		warthog::search::problem_instance pi2(start, target);
+		warthog::search::solution sol;
+		lrta.get_path(&pi2, &par, &sol);
+
+		REQUIRE(sol.sum_of_edge_costs_ != warthog::COST_MAX);
+		REQUIRE(sol.path_.front() == start);
+		REQUIRE(sol.path_.back() == target);
+		REQUIRE(lrta.get_max_step_expanded() <= lookahead);
+		REQUIRE(
+		    sol.sum_of_edge_costs_
+		    >= Catch::Approx(opt.sum_of_edge_costs_).margin(1e-6));
+
+		// the trajectory is a sequence of moves between adjacent cells
+		for(size_t i = 1; i < sol.path_.size(); i++)
+		{
+			int32_t x, y, px, py;
+			expander.get_xy(sol.path_[i], x, y);
+			expander.get_xy(sol.path_[i - 1], px, py);
+			REQUIRE(std::abs(x - px) <= 1);
+			REQUIRE(std::abs(y - py) <= 1);
+		}
+
+		// learning persists from one query to the next
+		REQUIRE(lrta.get_learned_heuristic()->num_learned() > 0);
+		previous  = sol.sum_of_edge_costs_;
+		converged = previous == Catch::Approx(opt.sum_of_edge_costs_);
+	}
+	REQUIRE(converged);
+
+	lrta.reset_learning();
+	REQUIRE(lrta.get_learned_heuristic()->num_learned() == 0);
+}
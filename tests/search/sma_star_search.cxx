@@ -0,0 +1,148 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <random>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/memory/node_store.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/sma_star_search.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/pqueue.h>
+
+TEST_CASE("node_store allocate and deallocate", "[node_store]")
+{
+	warthog::memory::node_store<warthog::search::search_node> store;
+	for(uint32_t i = 0; i < 100; i++)
+	{
+		store.allocate(warthog::pad_id{i});
+	}
+	REQUIRE(store.size() == 100);
+	warthog::search::search_node* n = store.find(warthog::pad_id{42});
+	REQUIRE(n != nullptr);
+	REQUIRE(n->get_id() == warthog::pad_id{42});
+
+	store.deallocate(n);
+	REQUIRE(store.find(warthog::pad_id{42}) == nullptr);
+	REQUIRE(store.size() == 99);
+
+	warthog::search::search_node* m = store.allocate(warthog::pad_id{1000});
+	REQUIRE(store.find(warthog::pad_id{1000}) == m);
+	REQUIRE(store.size() == 100);
+	REQUIRE(store.peak() == 100);
+
+	store.clear();
+	REQUIRE(store.size() == 0);
+}
+
+TEST_CASE("sma_star_search is optimal under a memory cap", "[sma_star]")
+{
+	// 48x48 map with random obstacles
+	uint32_t width = 48, height = 48;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 25);
+	map.set_label(1, 1, true);
+	map.set_label(width - 2, height - 2, true);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::search_parameters par;
+
+	auto start  = expander.get_pack(1, 1);
+	auto target = expander.get_pack(width - 2, height - 2);
+	warthog::search::problem_instance pi(start, target);
+	warthog::search::solution opt;
+	astar.get_path(&pi, &par, &opt);
+	REQUIRE(opt.sum_of_edge_costs_ != warthog::COST_MAX);
+
+	size_t budget = GENERATE(100000u, 300u, 150u);
+	warthog::search::sma_star_search sma(&heuristic, &expander, budget);
+	warthog::search::problem_instance pi2(start, target);
+	warthog::search::solution sol;
+	sma.get_path(&pi2, &par, &sol);
+
+	REQUIRE(sma.get_peak_nodes() <= budget);
+	REQUIRE(sol.sum_of_edge_costs_ == Catch::Approx(opt.sum_of_edge_costs_));
+	REQUIRE(sol.path_.front() == start);
+	REQUIRE(sol.path_.back() == target);
+	if(budget < 400) { REQUIRE(sol.met_.nodes_pruned_ > 0); }
+}
+
+TEST_CASE("sma_star_search is optimal with a tight budget", "[sma_star]")
+{
+	// 64x64 map with sparse obstacles; the optimal path has 71 nodes.
+	// every key on the way has many ties, which the search must explore
+	// without ever lowering a bound it has backed up.
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 8);
+	map.set_label(1, 1, true);
+	map.set_label(width - 2, height - 2, true);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::search_parameters par;
+
+	auto start  = expander.get_pack(1, 1);
+	auto target = expander.get_pack(width - 2, height - 2);
+	warthog::search::problem_instance pi(start, target);
+	warthog::search::solution opt;
+	astar.get_path(&pi, &par, &opt);
+	REQUIRE(opt.sum_of_edge_costs_ != warthog::COST_MAX);
+	REQUIRE(opt.path_.size() > 64);
+
+	size_t budget = 100;
+	par.set_max_expansions_cutoff(1000000);
+	warthog::search::sma_star_search sma(&heuristic, &expander, budget);
+	warthog::search::problem_instance pi2(start, target);
+	warthog::search::solution sol;
+	sma.get_path(&pi2, &par, &sol);
+
+	REQUIRE(sma.get_peak_nodes() <= budget);
+	REQUIRE(sol.met_.nodes_pruned_ > 0);
+	REQUIRE(sol.sum_of_edge_costs_ == Catch::Approx(opt.sum_of_edge_costs_));
+	REQUIRE(sol.met_.lb_ == Catch::Approx(opt.sum_of_edge_costs_));
+}
+
+TEST_CASE("sma_star_search gives up when it stalls", "[sma_star]")
+{
+	// a budget which holds an optimal path, but not enough of the ties
+	// around it for the search to ever raise its f-value past them
+	uint32_t width = 32, height = 32;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 8);
+	map.set_label(1, 1, true);
+	map.set_label(width - 2, height - 2, true);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::search::search_parameters par;
+	par.set_max_expansions_cutoff(10000000);
+	warthog::search::sma_star_search sma(&heuristic, &expander, 40);
+	warthog::search::problem_instance pi(
+	    expander.get_pack(1, 1), expander.get_pack(width - 2, height - 2));
+	warthog::search::solution sol;
+	sma.get_path(&pi, &par, &sol);
+
+	REQUIRE(sol.sum_of_edge_costs_ == warthog::COST_MAX);
+	// it stops after 40000 expansions at the stalled key, long before
+	// the cutoff
+	REQUIRE(sol.met_.nodes_expanded_ < 100000);
+	REQUIRE(sma.get_peak_nodes() <= 40);
+}
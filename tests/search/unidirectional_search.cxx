@@ -0,0 +1,316 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <random>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/lazy_pqueue.h>
+#include <warthog/util/pqueue.h>
+
+namespace
+{
+
+// octile heuristic which counts its evaluations
+class counting_heuristic : public warthog::heuristic::octile_heuristic
+{
+public:
+	using octile_heuristic::octile_heuristic;
+
+	void
+	h(warthog::heuristic::heuristic_value* hv)
+	{
+		calls_++;
+		octile_heuristic::h(hv);
+	}
+
+	uint64_t calls_ = 0;
+};
+
+// checks that each node expanded has no larger h-value than any node
+// left on OPEN. h is f - g, which relaxing a node can round.
+struct h_order_listener
+{
+	warthog::util::pqueue_min_h* open = nullptr;
+	uint32_t out_of_order             = 0;
+
+	void
+	generate_node(
+	    warthog::search::search_node*, warthog::search::search_node*,
+	    warthog::cost_t, uint32_t)
+	{ }
+
+	void
+	expand_node(warthog::search::search_node* current)
+	{
+		warthog::search::search_node* next = open->peek();
+		if(next
+		   && next->get_f() - next->get_g() + 1e-3
+		       < current->get_f() - current->get_g())
+		{
+			out_of_order++;
+		}
+	}
+
+	void
+	relax_node(warthog::search::search_node*)
+	{ }
+};
+
+// true if consecutive states of @param path are adjacent traversable
+// cells of @param map, and their moves add up to @param cost
+bool
+valid_path(
+    warthog::domain::gridmap& map, std::vector<warthog::pack_id>& path,
+    double cost)
+{
+	double sum = 0;
+	for(size_t i = 0; i < path.size(); i++)
+	{
+		if(!map.get_label(map.to_padded_id(path[i]))) { return false; }
+		if(i == 0) { continue; }
+		uint32_t x1, y1, x2, y2;
+		map.to_unpadded_xy(path[i - 1], x1, y1);
+		map.to_unpadded_xy(path[i], x2, y2);
+		uint32_t dx = x1 > x2 ? x1 - x2 : x2 - x1;
+		uint32_t dy = y1 > y2 ? y1 - y2 : y2 - y1;
+		if(dx > 1 || dy > 1 || dx + dy == 0) { return false; }
+		sum += dx + dy == 2 ? warthog::DBL_ROOT_TWO : 1.0;
+	}
+	return sum == Catch::Approx(cost);
+}
+
+} // namespace
+
+TEST_CASE("lazy heuristic evaluation", "[unidirectional_search]")
+{
+	// 64x64 map with random obstacles
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 30);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	counting_heuristic eager_h(map.width(), map.height());
+	counting_heuristic lazy_h(map.width(), map.height());
+	warthog::util::pqueue_min open;
+
+	warthog::search::unidirectional_search<
+	    counting_heuristic, warthog::search::gridmap_expansion_policy,
+	    warthog::util::pqueue_min, warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::w_admissible>
+	    eager(&eager_h, &expander, &open);
+	warthog::search::unidirectional_search<
+	    counting_heuristic, warthog::search::gridmap_expansion_policy,
+	    warthog::util::pqueue_min, warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::w_admissible,
+	    warthog::search::feasibility_criteria::until_exhaustion,
+	    warthog::search::reopen_policy::no,
+	    warthog::search::heuristic_evaluation::lazy>
+	    lazy(&lazy_h, &expander, &open);
+	warthog::search::search_parameters par;
+
+	uint32_t solved = 0;
+	std::uniform_int_distribution<uint32_t> cell(0, width * height - 1);
+	for(int i = 0; i < 50; i++)
+	{
+		uint32_t s = cell(rng), t = cell(rng);
+		if(!map.get_label(map.to_padded_id(warthog::pack_id{s}))
+		   || !map.get_label(map.to_padded_id(warthog::pack_id{t})))
+		{
+			continue;
+		}
+		warthog::search::problem_instance pi1{
+		    warthog::pack_id{s}, warthog::pack_id{t}};
+		warthog::search::problem_instance pi2{
+		    warthog::pack_id{s}, warthog::pack_id{t}};
+		warthog::search::solution sol1, sol2;
+		eager.get_path(&pi1, &par, &sol1);
+		lazy.get_path(&pi2, &par, &sol2);
+
+		REQUIRE(
+		    sol1.sum_of_edge_costs_
+		    == Catch::Approx(sol2.sum_of_edge_costs_));
+		if(sol2.sum_of_edge_costs_ == warthog::COST_MAX) { continue; }
+		REQUIRE(sol2.path_.front() == warthog::pack_id{s});
+		REQUIRE(sol2.path_.back() == warthog::pack_id{t});
+		solved++;
+	}
+	REQUIRE(solved > 10);
+	REQUIRE(lazy_h.calls_ < eager_h.calls_);
+}
+
+TEST_CASE("lazy deletion open list", "[unidirectional_search]")
+{
+	// 64x64 map with random obstacles
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 30);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::util::lazy_pqueue<> lazy_open;
+
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, warthog::util::pqueue_min,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::w_admissible>
+	    astar(&heuristic, &expander, &open);
+	warthog::search::unidirectional_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, warthog::util::lazy_pqueue<>,
+	    warthog::search::dummy_listener,
+	    warthog::search::admissibility_criteria::w_admissible>
+	    lazy(&heuristic, &expander, &lazy_open);
+	warthog::search::search_parameters par;
+
+	uint32_t solved = 0;
+	std::uniform_int_distribution<uint32_t> cell(0, width * height - 1);
+	for(int i = 0; i < 50; i++)
+	{
+		warthog::pack_id s{cell(rng)}, t{cell(rng)};
+		if(!map.get_label(map.to_padded_id(s))
+		   || !map.get_label(map.to_padded_id(t)))
+		{
+			continue;
+		}
+		warthog::search::problem_instance pi1{s, t};
+		warthog::search::problem_instance pi2{s, t};
+		warthog::search::solution sol1, sol2;
+		astar.get_path(&pi1, &par, &sol1);
+		lazy.get_path(&pi2, &par, &sol2);
+
+		REQUIRE(
+		    sol1.sum_of_edge_costs_
+		    == Catch::Approx(sol2.sum_of_edge_costs_));
+		if(sol2.sum_of_edge_costs_ == warthog::COST_MAX) { continue; }
+		REQUIRE(sol2.path_.front() == s);
+		REQUIRE(sol2.path_.back() == t);
+		solved++;
+	}
+	REQUIRE(solved > 10);
+}
+
+TEST_CASE("greedy best-first search", "[unidirectional_search]")
+{
+	// 64x64 map with random obstacles
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(23);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 25);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::util::pqueue_min_h greedy_open;
+	h_order_listener listener;
+	listener.open = &greedy_open;
+
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::greedy_best_first_search<
+	    warthog::heuristic::octile_heuristic,
+	    warthog::search::gridmap_expansion_policy, h_order_listener>
+	    gbfs(&heuristic, &expander, &greedy_open, &listener);
+	warthog::search::search_parameters par;
+
+	uint32_t solved = 0;
+	uint64_t astar_expanded = 0, gbfs_expanded = 0;
+	std::uniform_int_distribution<uint32_t> cell(0, width * height - 1);
+	for(int i = 0; i < 50; i++)
+	{
+		warthog::pack_id s{cell(rng)}, t{cell(rng)};
+		if(!map.get_label(map.to_padded_id(s))
+		   || !map.get_label(map.to_padded_id(t)))
+		{
+			continue;
+		}
+		warthog::search::problem_instance pi1{s, t};
+		warthog::search::problem_instance pi2{s, t};
+		warthog::search::solution sol1, sol2;
+		astar.get_path(&pi1, &par, &sol1);
+		gbfs.get_path(&pi2, &par, &sol2);
+
+		// both find a path, or neither; greedy paths may be longer
+		REQUIRE(
+		    (sol1.sum_of_edge_costs_ == warthog::COST_MAX)
+		    == (sol2.sum_of_edge_costs_ == warthog::COST_MAX));
+		if(sol2.sum_of_edge_costs_ == warthog::COST_MAX) { continue; }
+		REQUIRE(
+		    sol2.sum_of_edge_costs_
+		    >= Catch::Approx(sol1.sum_of_edge_costs_));
+		REQUIRE(sol2.path_.front() == s);
+		REQUIRE(sol2.path_.back() == t);
+		REQUIRE(valid_path(map, sol2.path_, sol2.sum_of_edge_costs_));
+		astar_expanded += sol1.met_.nodes_expanded_;
+		gbfs_expanded  += sol2.met_.nodes_expanded_;
+		solved++;
+	}
+	REQUIRE(solved > 10);
+	REQUIRE(listener.out_of_order == 0);
+	REQUIRE(gbfs_expanded < astar_expanded);
+}
+
+TEST_CASE("weighted A* is w-suboptimal", "[unidirectional_search]")
+{
+	// 64x64 map with random obstacles
+	uint32_t width = 64, height = 64;
+	warthog::domain::gridmap map(height, width);
+	std::mt19937 rng(29);
+	std::uniform_int_distribution<int> coin(0, 99);
+	for(uint32_t y = 0; y < height; y++)
+		for(uint32_t x = 0; x < width; x++)
+			map.set_label(x, y, coin(rng) >= 30);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+	warthog::search::search_parameters par;
+	warthog::search::search_parameters wpar;
+	double w = GENERATE(1.5, 3.0);
+	wpar.set_w_admissibility(w);
+
+	uint32_t solved = 0;
+	std::uniform_int_distribution<uint32_t> cell(0, width * height - 1);
+	for(int i = 0; i < 50; i++)
+	{
+		warthog::pack_id s{cell(rng)}, t{cell(rng)};
+		if(!map.get_label(map.to_padded_id(s))
+		   || !map.get_label(map.to_padded_id(t)))
+		{
+			continue;
+		}
+		warthog::search::problem_instance pi1{s, t};
+		warthog::search::problem_instance pi2{s, t};
+		warthog::search::solution opt, sol;
+		astar.get_path(&pi1, &par, &opt);
+		astar.get_path(&pi2, &wpar, &sol);
+
+		REQUIRE(
+		    (opt.sum_of_edge_costs_ == warthog::COST_MAX)
+		    == (sol.sum_of_edge_costs_ == warthog::COST_MAX));
+		if(sol.sum_of_edge_costs_ == warthog::COST_MAX) { continue; }
+		REQUIRE(
+		    sol.sum_of_edge_costs_
+		    >= Catch::Approx(opt.sum_of_edge_costs_));
+		REQUIRE(
+		    sol.sum_of_edge_costs_
+		    <= Catch::Approx(w * opt.sum_of_edge_costs_));
+		REQUIRE(valid_path(map, sol.path_, sol.sum_of_edge_costs_));
+		solved++;
+	}
+	REQUIRE(solved > 10);
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <deque>
+#include <random>
+#include <warthog/search/search_node.h>
+#include <warthog/util/lazy_pqueue.h>
+
+using warthog::search::search_node;
+
+TEST_CASE("lazy_pqueue discards stale entries", "[lazy_pqueue]")
+{
+	std::mt19937 rng(13);
+	std::uniform_int_distribution<int> cost(1, 1000);
+
+	std::deque<search_node> nodes;
+	warthog::util::lazy_pqueue<> open(4);
+	for(uint32_t i = 0; i < 2000; i++)
+	{
+		nodes.emplace_back(warthog::pad_id{i});
+		warthog::cost_t g = cost(rng);
+		nodes.back().init(0, warthog::pad_id::max(), g, g + cost(rng));
+		open.push(&nodes.back());
+	}
+
+	// improve some nodes, twice; each improvement adds an entry
+	for(int k = 0; k < 2; k++)
+	{
+		for(uint32_t i = 0; i < 2000; i += 5)
+		{
+			search_node& n = nodes[i];
+			n.relax(n.get_g() / 2, warthog::pad_id{0});
+			open.push(&n);
+		}
+	}
+	REQUIRE(open.size() == 2800);
+
+	// every node comes out once, in order of its final key
+	std::vector<bool> seen(nodes.size(), false);
+	search_node* prev = nullptr;
+	uint32_t popped   = 0;
+	while(search_node* n = open.pop())
+	{
+		uint32_t id = (uint32_t)n->get_id().id;
+		REQUIRE_FALSE(seen[id]);
+		seen[id] = true;
+		if(prev)
+		{
+			REQUIRE(prev->get_f() <= n->get_f());
+			if(prev->get_f() == n->get_f())
+			{
+				REQUIRE(prev->get_g() >= n->get_g());
+			}
+		}
+		prev = n;
+		popped++;
+	}
+	REQUIRE(popped == 2000);
+	REQUIRE(open.size() == 0);
+	REQUIRE(open.peek() == nullptr);
+}
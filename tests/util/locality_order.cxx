@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+#include <warthog/util/locality_order.h>
+
+TEST_CASE("hilbert_index follows a curve", "[locality_order]")
+{
+	// the first 4^k positions fill a square of 2^k cells, each next to
+	// the one before
+	std::vector<uint32_t> x(64 * 64), y(64 * 64);
+	std::vector<bool> seen(64 * 64, false);
+	for(uint32_t cy = 0; cy < 64; cy++)
+	{
+		for(uint32_t cx = 0; cx < 64; cx++)
+		{
+			uint32_t d = warthog::util::hilbert_index(cx, cy);
+			REQUIRE(d < 64 * 64);
+			REQUIRE_FALSE(seen[d]);
+			seen[d] = true;
+			x[d]    = cx;
+			y[d]    = cy;
+		}
+	}
+	for(uint32_t d = 1; d < 64 * 64; d++)
+	{
+		REQUIRE(
+		    std::abs((int)x[d] - (int)x[d - 1])
+		        + std::abs((int)y[d] - (int)y[d - 1])
+		    == 1);
+	}
+	REQUIRE(warthog::util::hilbert_index(0, 0) == 0);
+}
+
+TEST_CASE("locality_order sorts within windows", "[locality_order]")
+{
+	// queries alternate between two corners of the map
+	std::vector<uint64_t> keys;
+	for(uint32_t i = 0; i < 8; i++)
+	{
+		uint32_t c = i % 2 ? 9000 : 10;
+		keys.push_back(warthog::util::locality_key(c, c, c + 5, c));
+	}
+	REQUIRE(keys[0] == keys[2]);
+	REQUIRE(keys[0] < keys[1]);
+
+	std::vector<uint32_t> order(8);
+	std::iota(order.begin(), order.end(), 0);
+	warthog::util::locality_order(order, keys, 4);
+	REQUIRE(order == std::vector<uint32_t>{0, 2, 1, 3, 4, 6, 5, 7});
+
+	std::iota(order.begin(), order.end(), 0);
+	warthog::util::locality_order(order, keys, 0);
+	REQUIRE(order == std::vector<uint32_t>{0, 2, 4, 6, 1, 3, 5, 7});
+}
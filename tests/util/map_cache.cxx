@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <warthog/domain/gridmap.h>
+#include <warthog/util/map_cache.h>
+#include <warthog/util/scenario_manager.h>
+
+namespace
+{
+
+// a map of 100 bytes; loading "bad" fails
+struct fake_map
+{
+	fake_map(const std::string& name) : name_(name) { }
+
+	size_t
+	mem() const
+	{
+		return 100;
+	}
+
+	std::string name_;
+};
+
+struct counting_loader
+{
+	std::atomic<uint32_t>* loads_;
+
+	std::unique_ptr<fake_map>
+	operator()(const std::string& name) const
+	{
+		(*loads_)++;
+		if(name == "bad") { throw std::runtime_error("cannot load"); }
+		return std::make_unique<fake_map>(name);
+	}
+};
+
+} // namespace
+
+TEST_CASE("map_cache loads each map once", "[map_cache]")
+{
+	std::atomic<uint32_t> loads(0);
+	warthog::util::map_cache<fake_map> cache(1000, counting_loader{&loads});
+
+	auto a = cache.get("a");
+	REQUIRE(a->name_ == "a");
+	REQUIRE(cache.get("a") == a);
+	REQUIRE(cache.get("b")->name_ == "b");
+	REQUIRE(loads == 2);
+	REQUIRE(cache.get_hits() == 1);
+	REQUIRE(cache.get_misses() == 2);
+	REQUIRE(cache.size() == 2);
+}
+
+TEST_CASE("map_cache evicts the least recently used map", "[map_cache]")
+{
+	std::atomic<uint32_t> loads(0);
+	warthog::util::map_cache<fake_map> cache(250, counting_loader{&loads});
+
+	cache.get("a");
+	cache.get("b");
+	cache.get("a"); // b is now the least recently used
+	cache.get("c");
+	REQUIRE(cache.contains("a"));
+	REQUIRE_FALSE(cache.contains("b"));
+	REQUIRE(cache.contains("c"));
+	REQUIRE(cache.get_evictions() == 1);
+
+	cache.get("b");
+	REQUIRE(loads == 4);
+	REQUIRE_FALSE(cache.contains("a"));
+}
+
+TEST_CASE("map_cache keeps maps in use", "[map_cache]")
+{
+	std::atomic<uint32_t> loads(0);
+	warthog::util::map_cache<fake_map> cache(0, counting_loader{&loads});
+
+	auto a = cache.get("a");
+	auto b = cache.get("b");
+	REQUIRE(cache.size() == 2);
+	REQUIRE(a->name_ == "a"); // still valid
+
+	a.reset();
+	cache.get("c");
+	REQUIRE_FALSE(cache.contains("a"));
+	REQUIRE(cache.contains("b"));
+
+	// evicted maps live on while they are held
+	b = cache.get("b");
+	cache.clear();
+	REQUIRE(cache.size() == 1);
+	REQUIRE(b->name_ == "b");
+}
+
+TEST_CASE("map_cache does not cache failed loads", "[map_cache]")
+{
+	std::atomic<uint32_t> loads(0);
+	warthog::util::map_cache<fake_map> cache(1000, counting_loader{&loads});
+
+	REQUIRE_THROWS(cache.get("bad"));
+	REQUIRE_FALSE(cache.contains("bad"));
+	REQUIRE_THROWS(cache.get("bad"));
+	REQUIRE(loads == 2);
+}
+
+TEST_CASE("map_cache shares maps between threads", "[map_cache]")
+{
+	std::atomic<uint32_t> loads(0);
+	warthog::util::map_cache<fake_map> cache(1000, counting_loader{&loads});
+
+	std::vector<std::shared_ptr<fake_map>> got(8);
+	std::vector<std::thread> threads;
+	for(uint32_t i = 0; i < got.size(); i++)
+	{
+		threads.emplace_back([&, i] { got[i] = cache.get("shared"); });
+	}
+	for(auto& t : threads)
+	{
+		t.join();
+	}
+	REQUIRE(loads == 1);
+	for(auto& map : got)
+	{
+		REQUIRE(map == got[0]);
+	}
+}
+
+TEST_CASE("map_cache loads gridmaps", "[map_cache]")
+{
+	auto path
+	    = std::filesystem::temp_directory_path() / "warthog_test_cache.map";
+	{
+		std::ofstream out(path);
+		out << "type octile\nheight 2\nwidth 3\nmap\n..@\n...\n";
+	}
+	warthog::util::map_cache<warthog::domain::gridmap> cache(1 << 20);
+	auto map = cache.get(path.string());
+	REQUIRE(map->header_width() == 3);
+	REQUIRE(map->get_num_traversable_tiles() == 5);
+	REQUIRE(cache.mem() > map->mem());
+	std::filesystem::remove(path);
+	REQUIRE_THROWS(cache.get(path.string() + ".missing"));
+}
+
+TEST_CASE("scenario_manager splits instances by map", "[map_cache]")
+{
+	warthog::util::scenario_manager scenmgr;
+	const char* maps[] = {"x.map", "y.map", "x.map", "z.map", "y.map"};
+	for(uint32_t i = 0; i < 5; i++)
+	{
+		scenmgr.add_experiment(
+		    new warthog::util::experiment(i, 0, 0, 0, 8, 8, 0, maps[i]));
+	}
+	REQUIRE(scenmgr.num_maps() == 3);
+
+	std::vector<std::vector<uint32_t>> index;
+	auto groups = scenmgr.split_by_map(&index);
+	REQUIRE(scenmgr.num_experiments() == 0);
+	REQUIRE(groups.size() == 3);
+	REQUIRE(index == std::vector<std::vector<uint32_t>>{{0, 2}, {1, 4}, {3}});
+	REQUIRE(groups[0]->get_experiment(1)->startx() == 2);
+	REQUIRE(groups[1]->get_experiment(0)->map() == "y.map");
+	REQUIRE(groups[2]->num_experiments() == 1);
+}
+
+TEST_CASE("scenario_manager splits instances into chunks", "[map_cache]")
+{
+	warthog::util::scenario_manager scenmgr;
+	for(uint32_t i = 0; i < 7; i++)
+	{
+		scenmgr.add_experiment(
+		    new warthog::util::experiment(i, 0, 0, 0, 8, 8, 0, "x.map"));
+	}
+	auto chunks = scenmgr.split_by_size(3);
+	REQUIRE(scenmgr.num_experiments() == 0);
+	REQUIRE(chunks.size() == 3);
+	REQUIRE(chunks[0]->num_experiments() == 3);
+	REQUIRE(chunks[1]->get_experiment(0)->startx() == 3);
+	REQUIRE(chunks[2]->num_experiments() == 1);
+	REQUIRE(chunks[2]->get_experiment(0)->startx() == 6);
+}
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <deque>
+#include <random>
+#include <vector>
+#include <warthog/search/search_node.h>
+#include <warthog/util/minmax_heap.h>
+
+using warthog::search::search_node;
+
+namespace
+{
+
+// the f-values held by @param nodes that are still in @param heap
+std::vector<warthog::cost_t>
+f_values(warthog::util::minmax_heap_min& heap, std::deque<search_node>& nodes)
+{
+	std::vector<warthog::cost_t> fs;
+	for(auto& n : nodes)
+	{
+		if(heap.contains(&n)) { fs.push_back(n.get_f()); }
+	}
+	std::sort(fs.begin(), fs.end());
+	return fs;
+}
+
+} // namespace
+
+TEST_CASE("minmax_heap orders both ends", "[minmax_heap]")
+{
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> cost(0, 500);
+	std::uniform_int_distribution<int> op(0, 9);
+
+	std::deque<search_node> nodes;
+	warthog::util::minmax_heap_min heap(4);
+	for(int i = 0; i < 5000; i++)
+	{
+		int which = op(rng);
+		if(which < 5 || heap.size() == 0)
+		{
+			nodes.emplace_back(warthog::pad_id(nodes.size()));
+			nodes.back().init(0, warthog::pad_id::max(), 0, cost(rng));
+			heap.push(&nodes.back());
+		}
+		else if(which < 7)
+		{
+			auto fs = f_values(heap, nodes);
+			REQUIRE(heap.peek()->get_f() == fs.front());
+			REQUIRE(heap.pop()->get_f() == fs.front());
+		}
+		else if(which < 9)
+		{
+			auto fs = f_values(heap, nodes);
+			REQUIRE(heap.peek_max()->get_f() == fs.back());
+			REQUIRE(heap.pop_max()->get_f() == fs.back());
+		}
+		else
+		{
+			// lower the key of some node still in the heap
+			for(auto& n : nodes)
+			{
+				if(heap.contains(&n) && n.get_f() > 1)
+				{
+					n.set_f(n.get_f() / 2);
+					heap.decrease_key(&n);
+					break;
+				}
+			}
+		}
+		REQUIRE(heap.size() == f_values(heap, nodes).size());
+	}
+
+	// drain in order
+	warthog::cost_t last = -1;
+	while(heap.size())
+	{
+		search_node* n = heap.pop();
+		REQUIRE(n->get_f() >= last);
+		last = n->get_f();
+	}
+}
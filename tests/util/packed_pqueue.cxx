@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include <deque>
+#include <random>
+#include <vector>
+#include <warthog/search/search_node.h>
+#include <warthog/util/packed_pqueue.h>
+
+using warthog::search::search_node;
+using warthog::search::tie_breaking;
+
+namespace
+{
+
+// ids of the nodes, in the order they are popped
+template<tie_breaking TB>
+std::vector<uint32_t>
+pop_order(std::deque<search_node>& nodes)
+{
+	warthog::util::packed_pqueue<TB> open;
+	for(auto& n : nodes)
+	{
+		open.push(&n);
+	}
+	std::vector<uint32_t> ids;
+	while(open.size())
+	{
+		ids.push_back((uint32_t)open.pop()->get_id().id);
+	}
+	return ids;
+}
+
+} // namespace
+
+TEST_CASE("packed_pqueue breaks f-ties by policy", "[packed_pqueue]")
+{
+	// three nodes with equal f and one with a smaller f
+	std::deque<search_node> nodes;
+	for(uint32_t i = 0; i < 4; i++)
+	{
+		nodes.emplace_back(warthog::pad_id{i});
+	}
+	nodes[0].init(0, warthog::pad_id::max(), 2, 10);
+	nodes[1].init(0, warthog::pad_id::max(), 5, 10);
+	nodes[2].init(0, warthog::pad_id::max(), 3, 10);
+	nodes[3].init(0, warthog::pad_id::max(), 1, 9.5);
+
+	using ids = std::vector<uint32_t>;
+	REQUIRE(pop_order<tie_breaking::larger_g>(nodes) == ids{3, 1, 2, 0});
+	REQUIRE(pop_order<tie_breaking::smaller_h>(nodes) == ids{3, 1, 2, 0});
+	REQUIRE(pop_order<tie_breaking::lifo>(nodes) == ids{3, 2, 1, 0});
+	REQUIRE(pop_order<tie_breaking::fifo>(nodes) == ids{3, 0, 1, 2});
+}
+
+TEST_CASE("packed_pqueue orders by f", "[packed_pqueue]")
+{
+	std::mt19937 rng(9);
+	std::uniform_int_distribution<int> cost(0, 1000);
+
+	std::deque<search_node> nodes;
+	warthog::util::packed_pqueue<tie_breaking::larger_g> open(4);
+	for(uint32_t i = 0; i < 2000; i++)
+	{
+		nodes.emplace_back(warthog::pad_id{i});
+		warthog::cost_t g = cost(rng) / 8.0;
+		nodes.back().init(0, warthog::pad_id::max(), g, g + cost(rng));
+		open.push(&nodes.back());
+	}
+
+	// improve some nodes while they are queued
+	for(uint32_t i = 0; i < 2000; i += 7)
+	{
+		search_node& n = nodes[i];
+		if(n.get_g() == 0) { continue; }
+		n.relax(n.get_g() / 2, warthog::pad_id{0});
+		REQUIRE(open.contains(&n));
+		open.decrease_key(&n);
+	}
+
+	search_node* prev = open.pop();
+	REQUIRE_FALSE(open.contains(prev));
+	while(open.size())
+	{
+		search_node* n = open.pop();
+		REQUIRE(prev->get_f() <= n->get_f());
+		if(prev->get_f() == n->get_f())
+		{
+			REQUIRE(prev->get_g() >= n->get_g());
+		}
+		prev = n;
+	}
+	REQUIRE(open.peek() == nullptr);
+}
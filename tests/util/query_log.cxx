@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <warthog/domain/gridmap.h>
+#include <warthog/heuristic/octile_heuristic.h>
+#include <warthog/search/compact_path.h>
+#include <warthog/search/gridmap_expansion_policy.h>
+#include <warthog/search/unidirectional_search.h>
+#include <warthog/util/pqueue.h>
+#include <warthog/util/query_log.h>
+
+TEST_CASE("query_log records searches", "[query_log]")
+{
+	auto path = std::filesystem::temp_directory_path() / "warthog_test.qlog";
+	warthog::domain::gridmap map(32, 48);
+	for(uint32_t y = 0; y < 32; y++)
+		for(uint32_t x = 0; x < 48; x++)
+			map.set_label(x, y, x != 20 || y == 31);
+
+	warthog::search::gridmap_expansion_policy expander(&map);
+	warthog::heuristic::octile_heuristic heuristic(map.width(), map.height());
+	warthog::util::pqueue_min open;
+	warthog::search::unidirectional_search astar(&heuristic, &expander, &open);
+
+	std::vector<warthog::search::solution> sols(4);
+	{
+		warthog::util::query_log_writer log(path.string().c_str());
+		warthog::util::query_recorder recorder(log, "a.map", 48, 32);
+		REQUIRE(log.add_map("a.map", 48, 32) == 0);
+		REQUIRE(log.add_map("b.map", 8, 8) == 1);
+
+		warthog::search::search_parameters par;
+		par.set_recorder(&recorder);
+		warthog::search::problem_instance pi(
+		    expander.get_pack(0, 0), expander.get_pack(47, 0));
+		astar.get_path(&pi, &par, &sols[0]);
+
+		par.set_w_admissibility(2);
+		warthog::search::problem_instance pi2(
+		    expander.get_pack(5, 5), expander.get_pack(6, 6));
+		astar.get_path(&pi2, &par, &sols[1]);
+
+		// every entry point is recorded
+		par.set_w_admissibility(1);
+		astar.get_pathcost(&pi, &par, &sols[2]);
+		warthog::search::compact_path cp;
+		astar.get_path(&pi, &par, &sols[3], &cp);
+		REQUIRE(log.num_queries() == 4);
+
+		// not recorded
+		par.set_recorder(nullptr);
+		astar.get_path(&pi2, &par, &sols[1]);
+		REQUIRE(log.num_queries() == 4);
+	}
+
+	warthog::util::query_log_reader log(path.string().c_str());
+	warthog::util::query_record r;
+	REQUIRE(log.next(r));
+	REQUIRE(log.maps().size() == 2);
+	REQUIRE(log.maps()[0].name_ == "a.map");
+	REQUIRE(log.maps()[0].width_ == 48);
+	REQUIRE(r.map_ == 0);
+	REQUIRE(r.start_ == 0);
+	REQUIRE(r.target_ == 47);
+	REQUIRE(r.weight_ == 1);
+	REQUIRE(r.cost_ == sols[0].sum_of_edge_costs_);
+	REQUIRE(r.expanded_ == sols[0].met_.nodes_expanded_);
+
+	uint64_t first = r.time_;
+	REQUIRE(log.next(r));
+	REQUIRE(r.weight_ == 2);
+	REQUIRE(r.start_ == 5 * 48 + 5);
+	REQUIRE(r.time_ >= first);
+	for(uint32_t i = 2; i < 4; i++)
+	{
+		REQUIRE(log.next(r));
+		REQUIRE(r.target_ == 47);
+		REQUIRE(r.cost_ == sols[i].sum_of_edge_costs_);
+	}
+	REQUIRE(sols[2].sum_of_edge_costs_ == sols[0].sum_of_edge_costs_);
+	REQUIRE_FALSE(log.next(r));
+	REQUIRE(log.maps()[1].name_ == "b.map");
+
+	// a log cut short is an error, not an empty log
+	auto size = std::filesystem::file_size(path);
+	std::filesystem::resize_file(path, size - 10);
+	warthog::util::query_log_reader cut(path.string().c_str());
+	for(uint32_t i = 0; i < 3; i++)
+	{
+		REQUIRE(cut.next(r));
+	}
+	REQUIRE_THROWS_AS(cut.next(r), std::runtime_error);
+
+	std::ofstream(path) << "not a log";
+	REQUIRE_THROWS_AS(
+	    warthog::util::query_log_reader(path.string().c_str()),
+	    std::runtime_error);
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <warthog/util/scenario_manager.h>
+#include <warthog/util/scenario_reader.h>
+#include <warthog/util/scenario_store.h>
+
+namespace
+{
+
+// write @param text to a temporary scenario file and return its name
+std::string
+write_scen(const char* name, const std::string& text)
+{
+	auto path = std::filesystem::temp_directory_path() / name;
+	std::ofstream out(path, std::ios::binary);
+	out << text;
+	return path.string();
+}
+
+const char* SCEN = "version 1\n"
+                   "0\ta.map\t8\t8\t1\t2\t3\t4\t5.5\n"
+                   "1 b.map 16 16 0 0 15 15 21.21320344\r\n"
+                   "\n"
+                   "0\ta.map\t8\t8\t4\t3\t2\t1\t5.50\n"
+                   "2\ta.map\t4\t4\t0\t0\t3\t3\t3";
+
+} // namespace
+
+TEST_CASE("scenario_reader streams queries", "[scenario_store]")
+{
+	auto file = write_scen("warthog_test_reader.scen", SCEN);
+	warthog::util::scenario_reader reader(file.c_str());
+	warthog::util::scenario_reader::query q;
+
+	REQUIRE(reader.next(q));
+	REQUIRE(q.map_ == "a.map");
+	REQUIRE(q.startx_ == 1);
+	REQUIRE(q.goaly_ == 4);
+	REQUIRE(q.distance_ == 5.5);
+	REQUIRE(q.precision_ == 1);
+
+	REQUIRE(reader.next(q));
+	REQUIRE(q.bucket_ == 1);
+	REQUIRE(q.mapwidth_ == 16);
+	REQUIRE(q.precision_ == 8);
+	REQUIRE(reader.line() == 3);
+
+	REQUIRE(reader.next(q));
+	REQUIRE(reader.line() == 5);
+	REQUIRE(reader.next(q));
+	REQUIRE(q.precision_ == 0);
+	REQUIRE_FALSE(reader.next(q));
+	std::filesystem::remove(file);
+}
+
+TEST_CASE("scenario_reader rejects malformed files", "[scenario_store]")
+{
+	auto file = write_scen("warthog_test_reader.scen", "0 a.map 8 8\n");
+	REQUIRE_THROWS_AS(
+	    warthog::util::scenario_reader(file.c_str()), std::runtime_error);
+
+	file = write_scen(
+	    "warthog_test_reader.scen", "version 1\n0 a.map 8 8 1 2 3 x 4\n");
+	warthog::util::scenario_reader reader(file.c_str());
+	warthog::util::scenario_reader::query q;
+	REQUIRE_THROWS_AS(reader.next(q), std::runtime_error);
+	std::filesystem::remove(file);
+
+	REQUIRE_THROWS_AS(
+	    warthog::util::scenario_reader(file.c_str()), std::runtime_error);
+}
+
+TEST_CASE("scenario_store interns maps and sorts", "[scenario_store]")
+{
+	auto file = write_scen("warthog_test_store.scen", SCEN);
+	warthog::util::scenario_store store;
+	store.load(file.c_str());
+	std::filesystem::remove(file);
+
+	REQUIRE(store.size() == 4);
+	// a.map appears at two sizes
+	REQUIRE(store.num_maps() == 3);
+	REQUIRE(store.map_id(0) == store.map_id(2));
+	REQUIRE(store.map_id(0) != store.map_id(3));
+	REQUIRE(store.map(3) == "a.map");
+	REQUIRE(store.mapwidth(3) == 4);
+	REQUIRE(store.get_instance(1).start_ == warthog::pack_id{0});
+	REQUIRE(store.get_instance(1).target_ == warthog::pack_id{255});
+
+	// equal distances keep their order
+	store.sort();
+	REQUIRE(store.distance(0) == 3);
+	REQUIRE(store.startx(1) == 1);
+	REQUIRE(store.startx(2) == 4);
+	REQUIRE(store.map(3) == "b.map");
+	REQUIRE(store.mapheight(3) == 16);
+}
+
+TEST_CASE("scenario_manager reads through the reader", "[scenario_store]")
+{
+	auto file = write_scen("warthog_test_manager.scen", SCEN);
+	warthog::util::scenario_manager scenmgr;
+	scenmgr.load_scenario(file.c_str());
+	std::filesystem::remove(file);
+
+	REQUIRE(scenmgr.num_experiments() == 4);
+	REQUIRE(scenmgr.get_experiment(1)->map() == "b.map");
+	REQUIRE(scenmgr.get_experiment(1)->precision() == 8);
+	scenmgr.sort();
+	REQUIRE(scenmgr.get_experiment(0)->distance() == 3);
+	REQUIRE(scenmgr.get_experiment(1)->startx() == 1);
+	REQUIRE(scenmgr.get_experiment(2)->startx() == 4);
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <warthog/domain/gridmap.h>
+#include <warthog/util/tuning_profile.h>
+
+namespace
+{
+
+std::filesystem::path
+temp_profile(const char* name)
+{
+	return std::filesystem::temp_directory_path() / name;
+}
+
+} // namespace
+
+TEST_CASE("tuning_profile round trip", "[tuning_profile]")
+{
+	warthog::util::tuning_profile prof;
+	prof.queue_                   = "lazy";
+	prof.tiebreak_                = "h";
+	prof.lazy_h_                  = true;
+	prof.movetable_               = true;
+	prof.stats_.width_            = 12;
+	prof.stats_.height_           = 5;
+	prof.stats_.traversable_      = 30;
+	prof.stats_.components_       = 2;
+	prof.stats_.obstacle_density_ = 0.5;
+	prof.stats_.corridor_ratio_   = 0.25;
+	REQUIRE(prof.name() == "lazy-h-lazy-movetable");
+
+	auto path = temp_profile("warthog_test.profile");
+	{
+		std::ofstream out(path);
+		prof.save(out);
+		out << "# comments are ignored\n";
+	}
+	warthog::util::tuning_profile loaded;
+	REQUIRE(loaded.load(path.c_str()));
+	REQUIRE(loaded.name() == prof.name());
+	REQUIRE(loaded.stats_.traversable_ == 30);
+	REQUIRE(loaded.stats_.components_ == 2);
+	REQUIRE(loaded.stats_.corridor_ratio_ == 0.25);
+
+	warthog::domain::gridmap map(5, 12);
+	REQUIRE_FALSE(loaded.matches(map));
+	for(uint32_t x = 0; x < 6; x++)
+		for(uint32_t y = 0; y < 5; y++)
+			map.set_label(x, y, true);
+	REQUIRE(loaded.matches(map));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("tuning_profile rejects invalid entries", "[tuning_profile]")
+{
+	auto path = temp_profile("warthog_test_bad.profile");
+	{
+		std::ofstream out(path);
+		out << "queue fibonacci\n";
+	}
+	warthog::util::tuning_profile prof;
+	prof.queue_ = "packed";
+	REQUIRE_FALSE(prof.load(path.c_str()));
+	// a failed load leaves the profile as it was
+	REQUIRE(prof.queue_ == "packed");
+	REQUIRE_FALSE(prof.load("/nonexistent/warthog.profile"));
+	std::filesystem::remove(path);
+}